@@ -2,13 +2,19 @@
 
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_system.h"
 #include "driver/i2s.h"
 #include "driver/rtc_io.h"
+#include "esp_heap_caps.h"
 
 
 
 #define I2S_NUM (I2S_NUM_0)
+#define I2S_DMA_BUF_LEN_MAX (534)
+
+// The rate controller never moves the sample rate more than 0.5%
+#define SYNC_DRIFT_MAX_PPM (5000)
 
 static int AudioSink = ODROID_AUDIO_SINK_SPEAKER;
 static float Volume = 1.0f;
@@ -16,6 +22,24 @@ static odroid_volume_level volumeLevel = ODROID_VOLUME_LEVEL3;
 static int volumeLevels[] = {0, 30, 60, 125, 187, 250, 375, 500, 750, 1000};
 static int audio_sample_rate;
 
+static int dma_buf_count;
+static int dma_buf_len;
+static int block_frames;
+static QueueHandle_t i2s_event_queue;
+static int underrun_count;
+static uint32_t blocked_us;
+static uint32_t frames_written;
+static uint32_t frames_played;
+static portMUX_TYPE frames_played_mux = portMUX_INITIALIZER_UNLOCKED;
+static int sync_target_frames;
+static uint32_t sync_emulated;
+static int sync_emulated_frac;
+static int sync_drift_ppm;
+static uint32_t resample_pos;
+static short resample_last[2];
+static short* resample_buffer;
+static int resample_buffer_frames;
+
 
 odroid_volume_level odroid_audio_volume_get()
 {
@@ -42,12 +66,29 @@ void odroid_audio_volume_change()
     odroid_settings_Volume_set(level);
 }
 
+static void odroid_audio_buffers_load()
+{
+    block_frames = odroid_settings_AudioBlock_get();
+    if (block_frames < 64) block_frames = 64;
+    else if (block_frames > 2048) block_frames = 2048;
+
+    dma_buf_count = odroid_settings_AudioDmaCount_get();
+    if (dma_buf_count < 2) dma_buf_count = 2;
+    else if (dma_buf_count > 16) dma_buf_count = 16;
+
+    // Small blocks get small DMA buffers, the latency is dma_buf_count * dma_buf_len
+    dma_buf_len = block_frames < I2S_DMA_BUF_LEN_MAX ? block_frames : I2S_DMA_BUF_LEN_MAX;
+}
+
 void odroid_audio_init(ODROID_AUDIO_SINK sink, int sample_rate)
 {
     printf("%s: sink=%d, sample_rate=%d\n", __func__, sink, sample_rate);
 
     AudioSink = sink;
     audio_sample_rate = sample_rate;
+    frames_written = 0;
+    frames_played = 0;
+    odroid_audio_buffers_load();
 
     // NOTE: buffer needs to be adjusted per AUDIO_SAMPLE_RATE
     if(AudioSink == ODROID_AUDIO_SINK_SPEAKER)
@@ -60,14 +101,14 @@ void odroid_audio_init(ODROID_AUDIO_SINK sink, int sample_rate)
             .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,                           //2-channels
             .communication_format = I2S_COMM_FORMAT_I2S_MSB,
             //.communication_format = I2S_COMM_FORMAT_PCM,
-            .dma_buf_count = 8,
+            .dma_buf_count = dma_buf_count,
             //.dma_buf_len = 1472 / 2,  // (368samples * 2ch * 2(short)) = 1472
-            .dma_buf_len = 534,  // (416samples * 2ch * 2(short)) = 1664
+            .dma_buf_len = dma_buf_len,  // (416samples * 2ch * 2(short)) = 1664
             .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,                                //Interrupt level 1
             .use_apll = 0 //1
         };
 
-        i2s_driver_install(I2S_NUM, &i2s_config, 0, NULL);
+        i2s_driver_install(I2S_NUM, &i2s_config, dma_buf_count * 2, &i2s_event_queue);
 
         i2s_set_pin(I2S_NUM, NULL);
         i2s_set_dac_mode(/*I2S_DAC_CHANNEL_LEFT_EN*/ I2S_DAC_CHANNEL_BOTH_EN);
@@ -80,14 +121,14 @@ void odroid_audio_init(ODROID_AUDIO_SINK sink, int sample_rate)
             .bits_per_sample = 16,
             .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,                           //2-channels
             .communication_format = I2S_COMM_FORMAT_I2S | I2S_COMM_FORMAT_I2S_MSB,
-            .dma_buf_count = 8,
+            .dma_buf_count = dma_buf_count,
             //.dma_buf_len = 1472 / 2,  // (368samples * 2ch * 2(short)) = 1472
-            .dma_buf_len = 534,  // (416samples * 2ch * 2(short)) = 1664
+            .dma_buf_len = dma_buf_len,  // (416samples * 2ch * 2(short)) = 1664
             .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,                                //Interrupt level 1
             .use_apll = 1
         };
 
-        i2s_driver_install(I2S_NUM, &i2s_config, 0, NULL);
+        i2s_driver_install(I2S_NUM, &i2s_config, dma_buf_count * 2, &i2s_event_queue);
 
         i2s_pin_config_t pin_config = {
             .bck_io_num = 4,
@@ -168,8 +209,186 @@ void odroid_audio_set_sink(ODROID_AUDIO_SINK sink)
     odroid_audio_init(sink, audio_sample_rate);
 }
 
+static void odroid_audio_update_played()
+{
+    i2s_event_t event;
+
+    // Every TX_DONE event is one DMA buffer handed back to the driver. Both
+    // the audio and the emulation task drain the queue
+    while (xQueueReceive(i2s_event_queue, &event, 0) == pdTRUE)
+    {
+        if (event.type == I2S_EVENT_TX_DONE)
+        {
+            portENTER_CRITICAL(&frames_played_mux);
+            frames_played += dma_buf_len;
+            portEXIT_CRITICAL(&frames_played_mux);
+        }
+    }
+
+    // Underrun: the DMA replayed old buffers, restart from an empty queue
+    portENTER_CRITICAL(&frames_played_mux);
+    if ((int32_t)(frames_written - frames_played) < 0)
+    {
+        frames_played = frames_written;
+        ++underrun_count;
+    }
+    portEXIT_CRITICAL(&frames_played_mux);
+}
+
+static int odroid_audio_queued_frames()
+{
+    odroid_audio_update_played();
+    return frames_written - frames_played;
+}
+
+void odroid_audio_sync_set(int target_ms)
+{
+    sync_target_frames = audio_sample_rate * target_ms / 1000;
+    if (sync_target_frames > dma_buf_count * dma_buf_len)
+        sync_target_frames = dma_buf_count * dma_buf_len;
+    sync_drift_ppm = 0;
+    sync_emulated = frames_played;
+    sync_emulated_frac = 0;
+
+    printf("%s: target=%dms (%d frames)\n", __func__, target_ms, sync_target_frames);
+}
+
+int odroid_audio_sync_wait(int frame_rate)
+{
+    if (sync_target_frames <= 0 || audio_sample_rate == 0)
+        return 0;
+
+    // The next emulated frame produces this many output frames
+    sync_emulated_frac += audio_sample_rate;
+    sync_emulated += sync_emulated_frac / frame_rate;
+    sync_emulated_frac %= frame_rate;
+
+    // The audio task produces whole blocks, half a block ahead of the
+    // target centers the queue on it
+    int ahead = sync_target_frames + block_frames / 2;
+    TickType_t timeout = pdMS_TO_TICKS(2 * 1000 / frame_rate) + 1;
+    TickType_t start = xTaskGetTickCount();
+
+    while (1)
+    {
+        odroid_audio_update_played();
+        int32_t lead = sync_emulated - frames_played;
+
+        if (lead < 0)
+        {
+            // Emulation too slow, don't let it catch up in a burst
+            sync_emulated = frames_played;
+            break;
+        }
+        if (lead <= ahead)
+            break;
+        if (xTaskGetTickCount() - start > timeout)
+        {
+            // Output stalled (menu, underrun), start over from where it is
+            sync_emulated = frames_played + ahead;
+            break;
+        }
+
+        // Wake up when the next DMA buffer has been played
+        i2s_event_t event;
+        xQueuePeek(i2s_event_queue, &event, 1);
+    }
+
+    return 1;
+}
+
+int odroid_audio_latency_get()
+{
+    if (audio_sample_rate == 0) return 0;
+    return odroid_audio_queued_frames() * 1000 / audio_sample_rate;
+}
+
+int odroid_audio_drift_get()
+{
+    return sync_drift_ppm;
+}
+
+int odroid_audio_block_frames_get()
+{
+    return block_frames;
+}
+
+int odroid_audio_underruns_get()
+{
+    return underrun_count;
+}
+
+int odroid_audio_blocked_ms_get()
+{
+    return blocked_us / 1000;
+}
+
+static int odroid_audio_resample(short* stereoAudioBuffer, int frameCount)
+{
+    int queued = odroid_audio_queued_frames();
+
+    // Proportional controller on the queue depth, smoothed to keep the
+    // pitch change inaudible
+    int error = queued - sync_target_frames;
+    int ppm = error * SYNC_DRIFT_MAX_PPM / sync_target_frames;
+    if (ppm > SYNC_DRIFT_MAX_PPM) ppm = SYNC_DRIFT_MAX_PPM;
+    else if (ppm < -SYNC_DRIFT_MAX_PPM) ppm = -SYNC_DRIFT_MAX_PPM;
+    sync_drift_ppm = (sync_drift_ppm * 7 + ppm) / 8;
+
+    // 16.16 step through the input; > 1.0 drains the queue
+    uint32_t step = 0x10000 + (0x10000 * sync_drift_ppm) / 1000000;
+
+    int maxFrames = frameCount + frameCount / 100 + 2;
+    if (maxFrames > resample_buffer_frames)
+    {
+        free(resample_buffer);
+        resample_buffer = heap_caps_malloc(maxFrames * 2 * sizeof(short), MALLOC_CAP_8BIT);
+        if (!resample_buffer) abort();
+        resample_buffer_frames = maxFrames;
+    }
+
+    // Linear interpolation, position 0 is the last frame of the previous
+    // block so that there is no discontinuity between blocks
+    short* out = resample_buffer;
+    int outFrames = 0;
+    while ((resample_pos >> 16) < frameCount)
+    {
+        int index = resample_pos >> 16;
+        int frac = (resample_pos & 0xffff) >> 1;
+        const short* a = index ? stereoAudioBuffer + (index - 1) * 2 : resample_last;
+        const short* b = stereoAudioBuffer + index * 2;
+
+        out[0] = a[0] + (((b[0] - a[0]) * frac) >> 15);
+        out[1] = a[1] + (((b[1] - a[1]) * frac) >> 15);
+        out += 2;
+        ++outFrames;
+
+        resample_pos += step;
+    }
+    resample_pos -= frameCount << 16;
+    resample_last[0] = stereoAudioBuffer[(frameCount - 1) * 2];
+    resample_last[1] = stereoAudioBuffer[(frameCount - 1) * 2 + 1];
+
+    return outFrames;
+}
+
+static int odroid_audio_write(short* stereoAudioBuffer, int len)
+{
+    uint32_t start = xthal_get_ccount();
+    int count = i2s_write_bytes(I2S_NUM, (const char *)stereoAudioBuffer, len, portMAX_DELAY);
+    blocked_us += (xthal_get_ccount() - start) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+    return count;
+}
+
 void odroid_audio_submit(short* stereoAudioBuffer, int frameCount)
 {
+    if (sync_target_frames > 0)
+    {
+        frameCount = odroid_audio_resample(stereoAudioBuffer, frameCount);
+        stereoAudioBuffer = resample_buffer;
+    }
+    frames_written += frameCount;
+
     short currentAudioSampleCount = frameCount * 2;
 
     if (AudioSink == ODROID_AUDIO_SINK_SPEAKER)
@@ -229,7 +448,7 @@ void odroid_audio_submit(short* stereoAudioBuffer, int frameCount)
         }
 
         int len = currentAudioSampleCount * sizeof(int16_t);
-        int count = i2s_write_bytes(I2S_NUM, (const char *)stereoAudioBuffer, len, portMAX_DELAY);
+        int count = odroid_audio_write(stereoAudioBuffer, len);
         if (count != len)
         {
             printf("i2s_write_bytes: count (%d) != len (%d)\n", count, len);
@@ -252,7 +471,7 @@ void odroid_audio_submit(short* stereoAudioBuffer, int frameCount)
             stereoAudioBuffer[i] = (short)sample;
         }
 
-        int count = i2s_write_bytes(I2S_NUM, (const char *)stereoAudioBuffer, len, portMAX_DELAY);
+        int count = odroid_audio_write(stereoAudioBuffer, len);
         if (count != len)
         {
             printf("i2s_write_bytes: count (%d) != len (%d)\n", count, len);
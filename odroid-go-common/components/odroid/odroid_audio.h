@@ -30,3 +30,10 @@ void odroid_audio_terminate();
 void odroid_audio_submit(short* stereoAudioBuffer, int frameCount);
 int odroid_audio_sample_rate_get();
 void odroid_audio_mute();
+void odroid_audio_sync_set(int target_ms);
+int odroid_audio_sync_wait(int frame_rate);
+int odroid_audio_latency_get();
+int odroid_audio_drift_get();
+int odroid_audio_block_frames_get();
+int odroid_audio_underruns_get();
+int odroid_audio_blocked_ms_get();
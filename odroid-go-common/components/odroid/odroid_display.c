@@ -1,6 +1,7 @@
 #pragma GCC optimize ("O3")
 
 #include "odroid_display.h"
+#include "odroid_trace.h"
 #include "image_sd_card_alert.h"
 #include "image_sd_card_unknown.h"
 #include "hourglass_empty_black_48dp.h"
@@ -159,6 +160,7 @@ static void spi_task(void *arg)
 
             esp_err_t ret = spi_device_get_trans_result(spi, &t, portMAX_DELAY);
             assert(ret==ESP_OK);
+            ODROID_TRACE_ASYNC_END(ODROID_TRACE_SPI, t)
 
             int dc = (int)t->user & 0x80;
             if(dc)
@@ -226,8 +228,11 @@ static inline void spi_put_transaction(spi_transaction_t* t)
     }
 
     if (use_polling) {
+        ODROID_TRACE_BEGIN(ODROID_TRACE_SPI)
         spi_device_polling_transmit(spi, t);
+        ODROID_TRACE_END(ODROID_TRACE_SPI)
     } else {
+        ODROID_TRACE_ASYNC_BEGIN(ODROID_TRACE_SPI, t)
         esp_err_t ret = spi_device_queue_trans(spi, t, portMAX_DELAY);
         assert(ret==ESP_OK);
 
@@ -21,6 +21,9 @@ static const char* NvsKey_ScaleDisabled = "ScaleDisabled";
 static const char* NvsKey_AudioSink = "AudioSink";
 static const char* NvsKey_GBPalette = "GBPalette";
 static const char* NvsKey_ForceInternalGameSelect = "ForceGameSelect";
+static const char* NvsKey_AudioLatency = "AudioLatency";
+static const char* NvsKey_AudioBlock = "AudioBlock";
+static const char* NvsKey_AudioDmaCount = "AudioDmaCount";
 
 char* odroid_util_GetFileName(const char* path)
 {
@@ -564,3 +567,111 @@ void odroid_settings_ForceInternalGameSelect_set(int32_t value)
     // Close
     nvs_close(my_handle);
 }
+
+int32_t odroid_settings_AudioLatency_get()
+{
+    int result = ODROID_AUDIO_LATENCY_DEFAULT;
+
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Read
+    err = nvs_get_i32(my_handle, NvsKey_AudioLatency, &result);
+    if (err == ESP_OK)
+    {
+        printf("%s: value=%d\n", __func__, result);
+    }
+
+    // Close
+    nvs_close(my_handle);
+
+    return result;
+}
+void odroid_settings_AudioLatency_set(int32_t value)
+{
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Write
+    err = nvs_set_i32(my_handle, NvsKey_AudioLatency, value);
+    if (err != ESP_OK) abort();
+
+    // Close
+    nvs_close(my_handle);
+}
+
+int32_t odroid_settings_AudioBlock_get()
+{
+    int result = ODROID_AUDIO_BLOCK_DEFAULT;
+
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Read
+    err = nvs_get_i32(my_handle, NvsKey_AudioBlock, &result);
+    if (err == ESP_OK)
+    {
+        printf("%s: value=%d\n", __func__, result);
+    }
+
+    // Close
+    nvs_close(my_handle);
+
+    return result;
+}
+void odroid_settings_AudioBlock_set(int32_t value)
+{
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Write
+    err = nvs_set_i32(my_handle, NvsKey_AudioBlock, value);
+    if (err != ESP_OK) abort();
+
+    // Close
+    nvs_close(my_handle);
+}
+
+int32_t odroid_settings_AudioDmaCount_get()
+{
+    int result = ODROID_AUDIO_DMA_COUNT_DEFAULT;
+
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Read
+    err = nvs_get_i32(my_handle, NvsKey_AudioDmaCount, &result);
+    if (err == ESP_OK)
+    {
+        printf("%s: value=%d\n", __func__, result);
+    }
+
+    // Close
+    nvs_close(my_handle);
+
+    return result;
+}
+void odroid_settings_AudioDmaCount_set(int32_t value)
+{
+    // Open
+    nvs_handle my_handle;
+    esp_err_t err = nvs_open(NvsNamespace, NVS_READWRITE, &my_handle);
+    if (err != ESP_OK) abort();
+
+    // Write
+    err = nvs_set_i32(my_handle, NvsKey_AudioDmaCount, value);
+    if (err != ESP_OK) abort();
+
+    // Close
+    nvs_close(my_handle);
+}
@@ -26,6 +26,13 @@ typedef enum
     ODROID_AUDIO_SINK_DAC
 } ODROID_AUDIO_SINK;
 
+// Target audio latency in ms for the rate controller, 0 disables it
+#define ODROID_AUDIO_LATENCY_DEFAULT (100)
+// Frames produced by the emulator per audio block
+#define ODROID_AUDIO_BLOCK_DEFAULT (1024)
+// Number of I2S DMA buffers
+#define ODROID_AUDIO_DMA_COUNT_DEFAULT (8)
+
 
 int32_t odroid_settings_VRef_get();
 void odroid_settings_VRef_set(int32_t value);
@@ -59,3 +66,12 @@ void odroid_settings_GBPalette_set(int32_t value);
 
 int32_t odroid_settings_ForceInternalGameSelect_get();
 void odroid_settings_ForceInternalGameSelect_set(int32_t value);
+
+int32_t odroid_settings_AudioLatency_get();
+void odroid_settings_AudioLatency_set(int32_t value);
+
+int32_t odroid_settings_AudioBlock_get();
+void odroid_settings_AudioBlock_set(int32_t value);
+
+int32_t odroid_settings_AudioDmaCount_get();
+void odroid_settings_AudioDmaCount_set(int32_t value);
@@ -0,0 +1,202 @@
+#include "odroid_trace.h"
+
+#ifdef ODROID_TRACE_USE
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+#define ODROID_TRACE_RINGS portNUM_PROCESSORS
+#else
+#include <pthread.h>
+#include <time.h>
+
+#define ODROID_TRACE_RINGS 16
+#endif
+
+typedef struct
+{
+    // Microseconds, wraps after 71 minutes
+    uint32_t time;
+    uint32_t tid;
+    // Matches the two ends of an async slice
+    uint32_t id;
+    uint16_t event;
+    char phase;
+    uint8_t reserved;
+} odroid_trace_entry;
+
+typedef struct
+{
+    odroid_trace_entry *entries;
+    // Events ever added, the ring keeps the last ODROID_TRACE_RING_SIZE ones
+    uint32_t head;
+} odroid_trace_ring;
+
+static odroid_trace_ring rings[ODROID_TRACE_RINGS];
+static volatile bool paused = false;
+
+static const char *event_names[ODROID_TRACE_MAX] = {
+    "cpu",
+    "loop6502",
+    "render band",
+    "video",
+    "spi",
+    "audio",
+};
+
+static odroid_trace_entry *ring_alloc()
+{
+#ifdef ESP_PLATFORM
+    return heap_caps_calloc(ODROID_TRACE_RING_SIZE, sizeof(odroid_trace_entry), MALLOC_CAP_SPIRAM);
+#else
+    return calloc(ODROID_TRACE_RING_SIZE, sizeof(odroid_trace_entry));
+#endif
+}
+
+#ifdef ESP_PLATFORM
+
+static inline odroid_trace_ring *ring_get()
+{
+    odroid_trace_ring *ring = &rings[xPortGetCoreID()];
+
+    // Tasks of the same core may race here, the loser frees its ring
+    if (!ring->entries)
+    {
+        odroid_trace_entry *entries = ring_alloc();
+        odroid_trace_entry *expected = NULL;
+        if (!entries) return NULL;
+        if (!__atomic_compare_exchange_n(&ring->entries, &expected, entries, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            heap_caps_free(entries);
+    }
+    return ring;
+}
+
+static inline uint32_t time_get()
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+static inline uint32_t tid_get()
+{
+    return (uint32_t)xTaskGetCurrentTaskHandle();
+}
+
+#else
+
+static __thread odroid_trace_ring *thread_ring = NULL;
+static uint32_t ring_count = 0;
+
+static inline odroid_trace_ring *ring_get()
+{
+    if (!thread_ring)
+    {
+        uint32_t index = __atomic_fetch_add(&ring_count, 1, __ATOMIC_RELAXED);
+        if (index >= ODROID_TRACE_RINGS) return NULL;
+        rings[index].entries = ring_alloc();
+        if (!rings[index].entries) return NULL;
+        thread_ring = &rings[index];
+    }
+    return thread_ring;
+}
+
+static inline uint32_t time_get()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000u + now.tv_nsec / 1000;
+}
+
+static inline uint32_t tid_get()
+{
+    return (uint32_t)pthread_self();
+}
+
+#endif
+
+void odroid_trace_add(int event, char phase, uint32_t id)
+{
+    if (paused) return;
+
+    odroid_trace_ring *ring = ring_get();
+    if (!ring) return;
+
+    uint32_t index = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+    odroid_trace_entry *entry = &ring->entries[index & (ODROID_TRACE_RING_SIZE - 1)];
+    entry->time = time_get();
+    entry->tid = tid_get();
+    entry->id = id;
+    entry->event = event;
+    entry->phase = phase;
+}
+
+int odroid_trace_dump(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        printf("%s: can't create %s\n", __func__, path);
+        return -1;
+    }
+
+    paused = true;
+    uint32_t count = 0;
+    fprintf(f, "{\"traceEvents\":[\n");
+
+    for (int r = 0; r < ODROID_TRACE_RINGS; r++)
+    {
+        odroid_trace_ring *ring = &rings[r];
+        if (!ring->entries) continue;
+
+        uint32_t head = ring->head;
+        uint32_t start = head > ODROID_TRACE_RING_SIZE ? head - ODROID_TRACE_RING_SIZE : 0;
+
+        fprintf(f, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+            count ? ",\n" : "", r,
+#ifdef ESP_PLATFORM
+            "core",
+#else
+            "thread",
+#endif
+            r);
+        count++;
+
+        // Entries of one ring are in order, up to a preemption between two
+        // tasks of the core, so the time is unwrapped with signed deltas
+        uint64_t time = 0;
+        uint32_t last = 0;
+        for (uint32_t i = start; i < head; i++)
+        {
+            odroid_trace_entry *entry = &ring->entries[i & (ODROID_TRACE_RING_SIZE - 1)];
+            time = (i == start) ? entry->time : time + (int32_t)(entry->time - last);
+            last = entry->time;
+
+            if (entry->phase == 'b' || entry->phase == 'e')
+                fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"id\":%u,\"ts\":%llu,\"pid\":%d,\"tid\":%u}",
+                    event_names[entry->event], event_names[entry->event], entry->phase,
+                    entry->id, (unsigned long long)time, r, entry->tid);
+            else
+                fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":%d,\"tid\":%u}",
+                    event_names[entry->event], entry->phase,
+                    (unsigned long long)time, r, entry->tid);
+            count++;
+        }
+        ring->head = 0;
+    }
+
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(f);
+    paused = false;
+
+    printf("%s: %u events written to %s\n", __func__, count, path);
+    return 0;
+}
+
+#endif
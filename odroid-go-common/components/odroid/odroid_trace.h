@@ -0,0 +1,57 @@
+#pragma once
+
+//#define ODROID_TRACE_USE
+
+/*
+ * Event tracer: every core (every thread on the host) has a ring of the last
+ * ODROID_TRACE_RING_SIZE events, each one a timestamp, an event id and a
+ * phase. odroid_trace_dump writes the rings in the Chrome trace JSON format,
+ * to be opened with chrome://tracing or Perfetto.
+ *
+ * Slices (BEGIN/END) must start and end in the same task. Work handed from
+ * a task to another, like SPI transactions, uses the ASYNC variants with an
+ * id matching both ends.
+ */
+
+#ifndef ODROID_TRACE_USE
+#define ODROID_TRACE_BEGIN(event)
+#define ODROID_TRACE_END(event)
+#define ODROID_TRACE_ASYNC_BEGIN(event, id)
+#define ODROID_TRACE_ASYNC_END(event, id)
+#else
+
+#include <stdint.h>
+
+#define ODROID_TRACE_BEGIN(event) odroid_trace_add(event, 'B', 0);
+#define ODROID_TRACE_END(event) odroid_trace_add(event, 'E', 0);
+#define ODROID_TRACE_ASYNC_BEGIN(event, id) odroid_trace_add(event, 'b', (uint32_t)(id));
+#define ODROID_TRACE_ASYNC_END(event, id) odroid_trace_add(event, 'e', (uint32_t)(id));
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Events of a ring, a power of two
+#define ODROID_TRACE_RING_SIZE 16384
+
+typedef enum
+{
+    ODROID_TRACE_CPU = 0,
+    ODROID_TRACE_LOOP6502,
+    ODROID_TRACE_RENDER_BAND,
+    ODROID_TRACE_VIDEO,
+    ODROID_TRACE_SPI,
+    ODROID_TRACE_AUDIO,
+    ODROID_TRACE_MAX,
+} odroid_trace_events;
+
+void odroid_trace_add(int event, char phase, uint32_t id);
+
+// Write the rings as Chrome trace JSON, then start them again. Returns 0 on success
+int odroid_trace_dump(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,6 +9,8 @@
 
 COMPONENT_ADD_INCLUDEDIRS := . ./includes ./engine ./netplay
 COMPONENT_SRCDIRS := . engine
+# Host tools
+COMPONENT_OBJEXCLUDE := huregress.o hurollback.o hurelay.o tinfl_zlib.o
 
 CFLAGS += -DLSB_FIRST=1 -Wno-all -Wno-error
 CPPFLAGS += -DLSB_FIRST=1 -Wno-all -Wno-error
@@ -1,5 +1,10 @@
     uchar ret;
 
+    // Pages 1-7 only reach here for the hardware bank or a mapper's trapped
+    // banks. Page 0 addresses are also used by ST0-ST2 whatever is mapped.
+    if ((A & 0xE000) && mmr[A >> 13] != 0xFF)
+        return mapper_read(A);
+
 #ifndef FINAL_RELEASE
     if ((A & 0x1F00) == 0x1A00)
         Log("AC Read at %04x\n", A);
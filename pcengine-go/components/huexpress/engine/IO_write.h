@@ -1,5 +1,12 @@
     //printf("w%04x,%02x ",A&0x3FFF,V);
 
+    // Pages 1-7 only reach here for the hardware bank or a mapper's trapped
+    // banks. Page 0 addresses are also used by ST0-ST2 whatever is mapped.
+    if ((A & 0xE000) && mmr[A >> 13] != 0xFF) {
+        mapper_write(A, V);
+        return;
+    }
+
     if ((A >= 0x800) && (A < 0x1800))   // We keep the io buffer value
         io.io_buffer = V;
 
@@ -179,15 +186,17 @@
                     int sourcecount = (IO_VDC_0F_DCR.W & 8) ? -1 : 1;
                     int destcount = (IO_VDC_0F_DCR.W & 4) ? -1 : 1;
 
-                    int source = IO_VDC_10_SOUR.W * 2;
-                    int dest = IO_VDC_11_DISTR.W * 2;
+                    int source = (IO_VDC_10_SOUR.W * 2) & (VRAMSIZE - 1);
+                    int dest = (IO_VDC_11_DISTR.W * 2) & (VRAMSIZE - 1);
 
                     int i;
 
+                    // Both addresses wrap around inside VRAM, a long or
+                    // decrementing transfer never leaves the buffer
                     for (i = 0; i < (IO_VDC_12_LENR.W + 1) * 2; i++) {
                         *(VRAM + dest) = *(VRAM + source);
-                        dest += destcount;
-                        source += sourcecount;
+                        dest = (dest + destcount) & (VRAMSIZE - 1);
+                        source = (source + sourcecount) & (VRAMSIZE - 1);
                     }
 
                     /*
@@ -601,6 +601,7 @@ handle_bios()
 		case 2:
 		case 3:
 		case 4:
+			cdda_pause();
 			break;
 		case 5:
 			HCD_pause_playing();
@@ -806,7 +807,7 @@ handle_bios()
 
 		io.adpcm_psize = get_16bit_zp_(_ax) << 1;
 
-		io.adpcm_rate = (uchar) (32 / (16 - (get_8bit_zp_(_dh) & 15)));
+		io.adpcm_rate = (uchar) (16 - (get_8bit_zp_(_dh) & 15));
 
 		new_adpcm_play = 1;
 
@@ -816,6 +817,7 @@ handle_bios()
 
 	case AD_STOP:
 		AdpcmFilledBuf = new_adpcm_play = 0;
+		io.adpcm_psize = 0;
 		rts();
 		break;
 
@@ -979,7 +981,8 @@ handle_bios()
 			case 2:
 			case 3:
 			case 4:
-				// ignoring cd playing
+				cdda_play_track(bcdbin[get_8bit_zp_(_al)],
+								(char) (get_8bit_zp_(_dh) & 1));
 				break;
 			case 5:
 				HCD_play_track(bcdbin[get_8bit_zp_(_al)],
@@ -989,12 +992,17 @@ handle_bios()
 		} else if (get_8bit_zp_(_bh) == 192) {	/* resume from pause if paused */
 			int status;
 
-			osd_cd_status(&status);
+			if (CD_emulation >= 2 && CD_emulation <= 4) {
+				if (!cdda_resume())
+					cdda_play_track(bcdbin[get_8bit_zp_(_al)], 0);
+			} else {
+				osd_cd_status(&status);
 
-			if (status == CDROM_AUDIO_PAUSED)
-				osd_cd_resume();
-			else
-				osd_cd_play_audio_track(bcdbin[get_8bit_zp_(_al)]);
+				if (status == CDROM_AUDIO_PAUSED)
+					osd_cd_resume();
+				else
+					osd_cd_play_audio_track(bcdbin[get_8bit_zp_(_al)]);
+			}
 
 		} else {
 			int status;
@@ -1020,7 +1028,9 @@ handle_bios()
 			case 2:
 			case 3:
 			case 4:
-				// ignoring cd playing
+				cdda_play_sectors(Time2HSG(min1, sec1, fra1),
+								  Time2HSG(min2, sec2, fra2),
+								  (char) (get_8bit_zp_(_dh) & 1));
 				break;
 			case 5:
 				//                  HCD_play_sectors(begin_sect, sect_len, get_8bit_zp_(_dh) & 1);
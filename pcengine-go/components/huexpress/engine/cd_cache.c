@@ -0,0 +1,302 @@
+/***************************************************************************/
+/*                                                                         */
+/*                      CD sector cache Source File                        */
+/*                                                                         */
+/*     Read ahead of the data track of CD images. Sectors live in a        */
+/*     direct mapped set of slots, a low priority task fills the slots     */
+/*     ahead of the last sector read while the access is sequential, so    */
+/*     most reads end up being a memcpy instead of a seek on the card.     */
+/*     Host builds have no prefetch task, sectors are read on a miss.      */
+/*                                                                         */
+/***************************************************************************/
+
+#include "cd_cache.h"
+#include "pce.h"
+
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#else
+#include <time.h>
+#endif
+
+typedef enum {
+	CD_CACHE_EMPTY = 0,
+	CD_CACHE_LOADING,
+	CD_CACHE_VALID
+} cd_cache_state;
+
+typedef struct {
+	volatile uint32 index;
+	volatile cd_cache_state state;
+} cd_cache_slot;
+
+static cd_cache_slot cd_cache_slots[CD_CACHE_SLOTS];
+static uchar *cd_cache_data = NULL;
+static uchar *cd_cache_staging = NULL;
+
+static FILE *cd_cache_file = NULL;
+static long cd_cache_base;
+static int cd_cache_stride;
+
+#ifdef ESP_PLATFORM
+//! Held while the file is accessed or slots are being loaded
+static SemaphoreHandle_t cd_cache_lock = NULL;
+
+//! Next sector the emulation is expected to read
+static QueueHandle_t cd_cache_hints = NULL;
+static TaskHandle_t cd_cache_task_handle;
+
+#define cd_cache_lock_take() xSemaphoreTake(cd_cache_lock, portMAX_DELAY)
+#define cd_cache_lock_give() xSemaphoreGive(cd_cache_lock)
+#define cd_cache_hint(index) xQueueOverwrite(cd_cache_hints, &(index))
+#else
+#define cd_cache_lock_take()
+#define cd_cache_lock_give()
+#define cd_cache_hint(index)
+#endif
+
+static uint32 cd_cache_last = 0xFFFFFFFF;
+static volatile int cd_cache_window = CD_CACHE_WINDOW_MIN;
+
+/* Statistics */
+static uint32 cd_cache_hits;
+static uint32 cd_cache_misses;
+static uint32 cd_cache_waits;
+static uint32 cd_cache_stall_us;
+
+
+//! Read count sectors from first into their slots, the lock must be held
+static int
+cd_cache_load(uint32 first, int count)
+{
+	int i, read;
+
+	for (i = 0; i < count; i++) {
+		cd_cache_slots[(first + i) % CD_CACHE_SLOTS].index = first + i;
+		cd_cache_slots[(first + i) % CD_CACHE_SLOTS].state =
+			CD_CACHE_LOADING;
+	}
+
+	read = 0;
+	if (fseek(cd_cache_file, cd_cache_base + (long) first * cd_cache_stride,
+			  SEEK_SET) == 0) {
+		/* the last sector of a raw track may miss its ecc bytes */
+		read = fread(cd_cache_staging, 1, count * cd_cache_stride,
+					 cd_cache_file);
+		read = (read + cd_cache_stride - 2048) / cd_cache_stride;
+	}
+
+	for (i = 0; i < count; i++) {
+		cd_cache_slot *slot = &cd_cache_slots[(first + i) % CD_CACHE_SLOTS];
+
+		if (i < read) {
+			memcpy(cd_cache_data + ((first + i) % CD_CACHE_SLOTS) * 2048,
+				   cd_cache_staging + i * cd_cache_stride, 2048);
+			slot->state = CD_CACHE_VALID;
+		} else
+			slot->state = CD_CACHE_EMPTY;
+	}
+
+	return read;
+}
+
+
+static int
+cd_cache_cached(uint32 index)
+{
+	cd_cache_slot *slot = &cd_cache_slots[index % CD_CACHE_SLOTS];
+
+	return slot->index == index && slot->state == CD_CACHE_VALID;
+}
+
+
+static uint32
+cd_cache_time_us(void)
+{
+#ifdef ESP_PLATFORM
+	return (uint32) esp_timer_get_time();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#endif
+}
+
+
+#ifdef ESP_PLATFORM
+static void
+cd_cache_task(void *arg)
+{
+	uint32 next, end, hint;
+	int count;
+
+	while (1) {
+		xQueueReceive(cd_cache_hints, &hint, portMAX_DELAY);
+
+		next = hint;
+		end = hint + cd_cache_window;
+
+		while (next < end) {
+			if (cd_cache_cached(next)) {
+				next++;
+				continue;
+			}
+
+			for (count = 1; count < CD_CACHE_BATCH && next + count < end;
+				 count++)
+				if (cd_cache_cached(next + count))
+					break;
+
+			xSemaphoreTake(cd_cache_lock, portMAX_DELAY);
+			if (!cd_cache_file || cd_cache_load(next, count) < count) {
+				/* closed, or past the end of the track */
+				xSemaphoreGive(cd_cache_lock);
+				break;
+			}
+			xSemaphoreGive(cd_cache_lock);
+
+			next += count;
+
+			// The emulation moved, follow it
+			if (xQueueReceive(cd_cache_hints, &hint, 0) == pdTRUE) {
+				next = hint;
+				end = hint + cd_cache_window;
+			}
+		}
+	}
+}
+#endif
+
+
+int
+cd_cache_open(FILE * file, long base, int stride)
+{
+	int i;
+
+	if (!cd_cache_data) {
+		cd_cache_data =
+			(uchar *) my_special_alloc(false, 1, CD_CACHE_SLOTS * 2048);
+		cd_cache_staging =
+			(uchar *) my_special_alloc(false, 1, CD_CACHE_BATCH * 2352);
+#ifdef ESP_PLATFORM
+		cd_cache_lock = xSemaphoreCreateMutex();
+		cd_cache_hints = xQueueCreate(1, sizeof(uint32));
+
+		// Below the audio and video tasks, like the CD audio reader
+		xTaskCreatePinnedToCore(&cd_cache_task, "cdCacheTask", 1024 * 2,
+								NULL, 3, &cd_cache_task_handle, 1);
+#endif
+	}
+
+	cd_cache_lock_take();
+
+	cd_cache_file = file;
+	cd_cache_base = base;
+	cd_cache_stride = stride;
+
+	for (i = 0; i < CD_CACHE_SLOTS; i++)
+		cd_cache_slots[i].state = CD_CACHE_EMPTY;
+
+	cd_cache_lock_give();
+
+	cd_cache_last = 0xFFFFFFFF;
+	cd_cache_window = CD_CACHE_WINDOW_MIN;
+	cd_cache_hits = cd_cache_misses = cd_cache_waits = 0;
+	cd_cache_stall_us = 0;
+
+	MESSAGE_INFO("CD cache: %d sectors, reading ahead %d to %d sectors\n",
+				 CD_CACHE_SLOTS, CD_CACHE_WINDOW_MIN, CD_CACHE_WINDOW_MAX);
+	return 0;
+}
+
+
+void
+cd_cache_close(void)
+{
+	if (!cd_cache_data)
+		return;
+
+	cd_cache_lock_take();
+	cd_cache_file = NULL;
+	cd_cache_lock_give();
+
+	cd_cache_dump_stats();
+}
+
+
+void
+cd_cache_read(uchar * p, uint32 index)
+{
+	cd_cache_slot *slot = &cd_cache_slots[index % CD_CACHE_SLOTS];
+	uint32 start;
+
+	// Sequential reads widen the window, any seek shrinks it back
+	if (index == cd_cache_last + 1)
+		cd_cache_window =
+			MIN(cd_cache_window + CD_CACHE_BATCH, CD_CACHE_WINDOW_MAX);
+	else if (index != cd_cache_last)
+		cd_cache_window = CD_CACHE_WINDOW_MIN;
+	cd_cache_last = index;
+
+	if (slot->index == index && slot->state == CD_CACHE_VALID) {
+		memcpy(p, cd_cache_data + (index % CD_CACHE_SLOTS) * 2048, 2048);
+
+		// Make sure the prefetch didn't reuse the slot meanwhile
+		if (slot->index == index && slot->state == CD_CACHE_VALID) {
+			cd_cache_hits++;
+			goto prefetch;
+		}
+	}
+
+	start = cd_cache_time_us();
+
+	/* the lock is held by the prefetch while the sector is loading */
+	if (slot->index == index && slot->state == CD_CACHE_LOADING)
+		cd_cache_waits++;
+
+	cd_cache_lock_take();
+
+	if (slot->index == index && slot->state == CD_CACHE_VALID)
+		cd_cache_hits++;
+	else {
+		cd_cache_misses++;
+		if (!cd_cache_file || cd_cache_load(index, 1) != 1)
+			MESSAGE_ERROR("CD cache: couldn't read sector %d\n", index);
+	}
+	memcpy(p, cd_cache_data + (index % CD_CACHE_SLOTS) * 2048, 2048);
+
+	cd_cache_lock_give();
+
+	cd_cache_stall_us += cd_cache_time_us() - start;
+
+  prefetch:
+	index++;
+	cd_cache_hint(index);
+
+	if (((cd_cache_hits + cd_cache_misses) & 0x3FF) == 0)
+		cd_cache_dump_stats();
+}
+
+
+void
+cd_cache_prefetch(uint32 index)
+{
+	if (cd_cache_data && !cd_cache_cached(index))
+		cd_cache_hint(index);
+}
+
+
+void
+cd_cache_dump_stats(void)
+{
+	MESSAGE_INFO("CD cache: hits=%d misses=%d waits=%d stalled=%dms\n",
+				 cd_cache_hits, cd_cache_misses, cd_cache_waits,
+				 cd_cache_stall_us / 1000);
+}
@@ -0,0 +1,33 @@
+#ifndef _CD_CACHE_H_
+#define _CD_CACHE_H_
+
+#include <stdio.h>
+
+#include "cleantypes.h"
+
+//! Sectors kept in memory (256KB), direct mapped on the sector index
+#define CD_CACHE_SLOTS 128
+
+//! Sectors read at once by the prefetch task
+#define CD_CACHE_BATCH 8
+
+//! Read ahead window, in sectors, grows while the access stays sequential
+#define CD_CACHE_WINDOW_MIN 16
+#define CD_CACHE_WINDOW_MAX 64
+
+//! Start caching a data track, sector n is 2048 bytes at base + n * stride
+int cd_cache_open(FILE * file, long base, int stride);
+
+//! Stop the read ahead and print the statistics
+void cd_cache_close(void);
+
+//! Copy the 2048 bytes of sector index (relative to base) into p
+void cd_cache_read(uchar * p, uint32 index);
+
+//! Start the read ahead from sector index, without waiting for it
+void cd_cache_prefetch(uint32 index);
+
+//! Print hits, misses and the time the emulation waited on the card
+void cd_cache_dump_stats(void);
+
+#endif
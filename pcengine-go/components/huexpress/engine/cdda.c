@@ -0,0 +1,556 @@
+/***************************************************************************/
+/*                                                                         */
+/*                         CD-DA Source File                               */
+/*                                                                         */
+/*     Streaming of the audio tracks of CD images. A low priority task     */
+/*     decodes the track file in chunks into a ring buffer which is        */
+/*     consumed by the audio task. Memory use is bounded by the ring,      */
+/*     a track is never decoded as a whole. Host builds have no task,      */
+/*     requests are handled at once and the mixer fills the ring.          */
+/*                                                                         */
+/*     Tracks listed in a cue sheet are read from the BIN or WAVE file     */
+/*     it gives, others are looked for next to the image, named after it:  */
+/*     Game.iso -> Game_03.wav, Game_04.wav, ...                           */
+/*                                                                         */
+/***************************************************************************/
+
+#include "cdda.h"
+#include "pce.h"
+
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#endif
+
+extern uchar cd_fade;
+
+typedef enum {
+	CDDA_STOPPED = 0,
+	CDDA_PLAYING,
+	CDDA_PAUSED
+} cdda_state_type;
+
+typedef enum {
+	CDDA_REQUEST_PLAY,
+	CDDA_REQUEST_STOP
+} cdda_request_type;
+
+typedef struct {
+	cdda_request_type type;
+	uchar track;
+	char repeat;
+	uint32 begin;				/* in sectors, relative to the track */
+	uint32 end;					/* in sectors, relative to the track, 0 for the whole track */
+} cdda_request;
+
+typedef struct {
+	FILE *file;
+	uint32 data_offset;			/* file offset of the first frame */
+	uint32 frames;				/* number of frames in the file */
+	uint32 rate;
+	uchar channels;
+} cdda_stream;
+
+typedef struct {
+	const char *extension;
+	int (*open) (cdda_stream *);
+	int (*read) (cdda_stream *, short *, int);
+	int (*seek) (cdda_stream *, uint32);
+} cdda_decoder;
+
+static int raw_open(cdda_stream *);
+static int wav_open(cdda_stream *);
+static int wav_read(cdda_stream *, short *, int);
+static int wav_seek(cdda_stream *, uint32);
+
+//! Known track formats, tried in this order
+static const cdda_decoder cdda_decoders[] = {
+	{".wav", wav_open, wav_read, wav_seek},
+};
+
+#define CDDA_DECODERS_NUMBER (sizeof(cdda_decoders) / sizeof(cdda_decoders[0]))
+
+//! Audio tracks of BIN images with a cue sheet, raw 44.1KHz 16 bit stereo
+static const cdda_decoder cdda_raw_decoder =
+	{".bin", raw_open, wav_read, wav_seek};
+
+#ifdef ESP_PLATFORM
+static QueueHandle_t cdda_queue = NULL;
+static TaskHandle_t cdda_task_handle;
+#endif
+static uchar cdda_started = 0;
+
+//! Ring of interleaved stereo frames, indexes only grow
+static short *cdda_ring = NULL;
+static volatile uint32 cdda_write = 0;		/* owned by the reader task */
+static volatile uint32 cdda_read = 0;		/* owned by the mixer */
+static volatile uint32 cdda_flush = 0;		/* frames before this are stale */
+static volatile uint32 cdda_rate = 44100;
+static volatile uchar cdda_eof = 0;
+static volatile cdda_state_type cdda_state = CDDA_STOPPED;
+
+/* Reader task state */
+static cdda_stream cdda_current;
+static const cdda_decoder *cdda_current_decoder = NULL;
+static uint32 cdda_begin_frame, cdda_end_frame, cdda_position;
+static char cdda_repeat;
+static uchar *cdda_chunk = NULL;
+static Track *cdda_raw_track = NULL;
+
+
+static uint32
+get_le32(uchar * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+
+static uint16
+get_le16(uchar * p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+
+static int
+raw_open(cdda_stream * stream)
+{
+	stream->channels = 2;
+	stream->rate = 44100;
+	stream->data_offset = cdda_raw_track->file_offset;
+	stream->frames = cdda_raw_track->length * (2352 / 4);
+	return 1;
+}
+
+
+static int
+wav_open(cdda_stream * stream)
+{
+	uchar header[16];
+	uint32 chunk_size;
+	uint16 format = 0, bits = 0;
+
+	if (fread(header, 12, 1, stream->file) != 1
+		|| memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4))
+		return 0;
+
+	stream->channels = 0;
+
+	while (fread(header, 8, 1, stream->file) == 1) {
+		chunk_size = get_le32(header + 4);
+
+		if (!memcmp(header, "fmt ", 4)) {
+			if (chunk_size < 16 || fread(header, 16, 1, stream->file) != 1)
+				return 0;
+			format = get_le16(header);
+			stream->channels = get_le16(header + 2);
+			stream->rate = get_le32(header + 4);
+			bits = get_le16(header + 14);
+			chunk_size -= 16;
+		} else if (!memcmp(header, "data", 4)) {
+			if (format != 1 || bits != 16
+				|| (stream->channels != 1 && stream->channels != 2)) {
+				MESSAGE_ERROR("CDDA: only 16 bit PCM wav are supported\n");
+				return 0;
+			}
+			stream->data_offset = ftell(stream->file);
+			stream->frames = chunk_size / (2 * stream->channels);
+			return 1;
+		}
+
+		// Chunks are word aligned
+		fseek(stream->file, (chunk_size + 1) & ~1, SEEK_CUR);
+	}
+
+	return 0;
+}
+
+
+static int
+wav_read(cdda_stream * stream, short *frames, int count)
+{
+	int i, read;
+
+	read = fread(cdda_chunk, 2 * stream->channels,
+				 MIN(count, CDDA_CHUNK_SIZE / (2 * stream->channels)),
+				 stream->file);
+
+	if (stream->channels == 2) {
+		for (i = 0; i < read * 2; i++)
+			frames[i] = (short) get_le16(cdda_chunk + i * 2);
+	} else {
+		for (i = 0; i < read; i++)
+			frames[i * 2] = frames[i * 2 + 1] =
+				(short) get_le16(cdda_chunk + i * 2);
+	}
+
+	return read;
+}
+
+
+static int
+wav_seek(cdda_stream * stream, uint32 frame)
+{
+	return fseek(stream->file, stream->data_offset
+				 + frame * 2 * stream->channels, SEEK_SET) == 0;
+}
+
+
+static void
+cdda_close(void)
+{
+	if (cdda_current.file)
+		fclose(cdda_current.file);
+	cdda_current.file = NULL;
+	cdda_current_decoder = NULL;
+}
+
+
+static int
+cdda_open(uchar track)
+{
+	static char path[256];
+	char *extension;
+	int length, i;
+
+	cdda_close();
+
+	// Tracks listed in a cue sheet are read from the file it gives
+	if (CD_track[track].sector_size == 2352 && CD_track[track].filename[0]) {
+		cdda_current.file = fopen(CD_track[track].filename, "rb");
+		if (cdda_current.file && wav_open(&cdda_current)) {
+			uint32 start = (uint64) (CD_track[track].file_offset / 2352)
+				* cdda_current.rate / 75;
+
+			// A WAVE file can hold several tracks too, skip to this one
+			start = MIN(start, cdda_current.frames);
+			cdda_current.data_offset += start * 2 * cdda_current.channels;
+			cdda_current.frames = MIN(cdda_current.frames - start,
+				(uint64) CD_track[track].length * cdda_current.rate / 75);
+			cdda_current_decoder = &cdda_decoders[0];
+			return 1;
+		} else if (cdda_current.file) {
+			cdda_raw_track = &CD_track[track];
+			raw_open(&cdda_current);
+			cdda_current_decoder = &cdda_raw_decoder;
+			return 1;
+		}
+	}
+
+	extension = strrchr(ISO_filename, '.');
+	length = extension ? extension - ISO_filename : strlen(ISO_filename);
+
+	for (i = 0; i < CDDA_DECODERS_NUMBER; i++) {
+		snprintf(path, sizeof(path), "%.*s_%02d%s", length, ISO_filename,
+				 track, cdda_decoders[i].extension);
+
+		cdda_current.file = fopen(path, "rb");
+		if (!cdda_current.file)
+			continue;
+
+		if (cdda_decoders[i].open(&cdda_current)) {
+			cdda_current_decoder = &cdda_decoders[i];
+			MESSAGE_INFO("CDDA: track %d is %s (%dHz, %d frames)\n", track,
+						 path, cdda_current.rate, cdda_current.frames);
+			return 1;
+		}
+
+		cdda_close();
+	}
+
+	MESSAGE_INFO("CDDA: no audio file for track %d\n", track);
+	return 0;
+}
+
+
+static void
+cdda_handle_request(cdda_request * request)
+{
+	cdda_state = CDDA_STOPPED;
+	cdda_eof = 1;
+
+	// Whatever is in the ring is not to be played anymore
+	cdda_flush = cdda_write;
+
+	if (request->type != CDDA_REQUEST_PLAY)
+		return;
+
+	if (!cdda_open(request->track))
+		return;
+
+	cdda_begin_frame = (uint64) request->begin * cdda_current.rate / 75;
+	cdda_end_frame = request->end
+		? (uint64) request->end * cdda_current.rate / 75
+		: cdda_current.frames;
+	cdda_end_frame = MIN(cdda_end_frame, cdda_current.frames);
+	cdda_repeat = request->repeat;
+
+	if (cdda_begin_frame >= cdda_end_frame
+		|| !cdda_current_decoder->seek(&cdda_current, cdda_begin_frame)) {
+		cdda_close();
+		return;
+	}
+
+	cdda_position = cdda_begin_frame;
+	cdda_rate = cdda_current.rate;
+	cdda_eof = 0;
+	cdda_state = CDDA_PLAYING;
+}
+
+
+//! Decode one chunk of the current track into the ring
+static void
+cdda_fill(void)
+{
+	uint32 index = cdda_write % CDDA_RING_FRAMES;
+	uint32 free = CDDA_RING_FRAMES - (cdda_write - cdda_read);
+	int count, read;
+
+	// Don't wrap inside a chunk, decode up to the end of the ring instead
+	count = MIN(CDDA_RING_FRAMES - index, cdda_end_frame - cdda_position);
+	count = MIN((uint32) count, free);
+
+	read = cdda_current_decoder->read(&cdda_current, cdda_ring + index * 2,
+									  count);
+	if (read <= 0) {
+		cdda_position = cdda_end_frame;
+	} else {
+		cdda_position += read;
+		cdda_write += read;
+	}
+
+	if (cdda_position >= cdda_end_frame) {
+		if (cdda_repeat
+			&& cdda_current_decoder->seek(&cdda_current, cdda_begin_frame))
+			cdda_position = cdda_begin_frame;
+		else
+			cdda_eof = 1;
+	}
+}
+
+
+#ifdef ESP_PLATFORM
+static void
+cdda_task(void *arg)
+{
+	cdda_request request;
+	TickType_t wait;
+
+	while (1) {
+		if (!cdda_current_decoder || cdda_eof)
+			wait = portMAX_DELAY;
+		else if (CDDA_RING_FRAMES - (cdda_write - cdda_read)
+				 < CDDA_CHUNK_SIZE / 4)
+			wait = 10 / portTICK_PERIOD_MS;
+		else
+			wait = 0;
+
+		if (xQueueReceive(cdda_queue, &request, wait) == pdTRUE) {
+			cdda_handle_request(&request);
+			continue;
+		}
+
+		if (!wait)
+			cdda_fill();
+	}
+}
+#endif
+
+
+static void
+cdda_send(cdda_request * request)
+{
+#ifdef ESP_PLATFORM
+	xQueueSend(cdda_queue, request, portMAX_DELAY);
+#else
+	cdda_handle_request(request);
+#endif
+}
+
+
+int
+cdda_init(void)
+{
+	if (cdda_started)
+		return 0;
+
+	cdda_ring = (short *) my_special_alloc(false, 4, CDDA_RING_FRAMES * 4);
+	cdda_chunk = (uchar *) my_special_alloc(false, 1, CDDA_CHUNK_SIZE);
+
+#ifdef ESP_PLATFORM
+	cdda_queue = xQueueCreate(4, sizeof(cdda_request));
+
+	// Lower priority than the audio task, SD latency must not stall the mix
+	xTaskCreatePinnedToCore(&cdda_task, "cddaTask", 1024 * 3, NULL, 3,
+							&cdda_task_handle, 1);
+#endif
+	cdda_started = 1;
+	return 0;
+}
+
+
+void
+cdda_shutdown(void)
+{
+	cdda_request request;
+
+	if (!cdda_started)
+		return;
+
+	request.type = CDDA_REQUEST_STOP;
+	cdda_send(&request);
+}
+
+
+void
+cdda_play_track(uchar track, char repeat)
+{
+	cdda_request request;
+
+	if (!cdda_started || CD_track[track].type != 0)
+		return;
+
+	request.type = CDDA_REQUEST_PLAY;
+	request.track = track;
+	request.repeat = repeat;
+	request.begin = 0;
+	request.end = 0;
+	cdda_send(&request);
+}
+
+
+void
+cdda_play_sectors(uint32 begin_lsn, uint32 end_lsn, char repeat)
+{
+	cdda_request request;
+	int track;
+
+	if (!cdda_started)
+		return;
+
+	track = find_cd_track(begin_lsn);
+	if (!track || CD_track[track].type != 0)
+		return;
+
+	request.type = CDDA_REQUEST_PLAY;
+	request.track = track;
+	request.repeat = repeat;
+	request.begin = begin_lsn - CD_track[track].beg_lsn;
+	/* can't yet play across the end of a track */
+	request.end = end_lsn > begin_lsn ? end_lsn - CD_track[track].beg_lsn : 0;
+	cdda_send(&request);
+}
+
+
+void
+cdda_pause(void)
+{
+	if (cdda_state == CDDA_PLAYING)
+		cdda_state = CDDA_PAUSED;
+}
+
+
+int
+cdda_resume(void)
+{
+	if (cdda_state != CDDA_PAUSED)
+		return 0;
+
+	cdda_state = CDDA_PLAYING;
+	return 1;
+}
+
+
+int
+cdda_playing(void)
+{
+	return cdda_state == CDDA_PLAYING;
+}
+
+
+void
+cdda_mix(short *buf, int frames, int rate)
+{
+	static uint32 fixed_n = 0;
+	static int32 fade = 256 << 16;
+	static int32 last_l = 0, last_r = 0;
+	uint32 fixed_inc;
+	int32 l, r, vol;
+	int i, n, count;
+
+	if (cdda_state != CDDA_PLAYING)
+		return;
+
+	// Skip what was queued before the last play request
+	if ((int32) (cdda_flush - cdda_read) > 0)
+		cdda_read = cdda_flush;
+
+#ifndef ESP_PLATFORM
+	// No reader task, decode what this block needs now
+	while (!cdda_eof && cdda_write - cdda_read
+		   < (uint64) frames * cdda_rate / rate + 1
+		   && cdda_write - cdda_read < CDDA_RING_FRAMES)
+		cdda_fill();
+#endif
+
+	/*
+	 * $180F : 0x08/0x09 fade the CD audio out in 6 sec, 0x0C/0x0D in 2.5 sec
+	 * the ADPCM fades (0x0A, 0x0E) leave it alone
+	 */
+	switch (cd_fade & 0x0F) {
+	case 0x08:
+	case 0x09:
+		fade -= ((256 << 16) / (6 * rate)) * frames;
+		break;
+	case 0x0C:
+	case 0x0D:
+		fade -= ((256 << 16) / (5 * rate / 2)) * frames;
+		break;
+	case 0x0A:
+	case 0x0E:
+		break;
+	default:
+		fade = 256 << 16;
+		break;
+	}
+	if (fade < 0)
+		fade = 0;
+	vol = fade >> 16;
+
+	/* average the source frames falling in each output frame */
+	fixed_inc = (cdda_rate << 16) / rate;
+
+	for (i = 0; i < frames; i++) {
+		fixed_n += fixed_inc;
+		n = fixed_n >> 16;
+		fixed_n &= 0xFFFF;
+
+		if (n) {
+			l = r = 0;
+			for (count = 0; count < n && cdda_read != cdda_write; count++) {
+				short *p = cdda_ring + (cdda_read % CDDA_RING_FRAMES) * 2;
+				l += p[0];
+				r += p[1];
+				cdda_read++;
+			}
+			if (count) {
+				last_l = l / count;
+				last_r = r / count;
+			}
+		}
+
+		// Half scale, to sit at the level of the psg mix
+		l = buf[i * 2] + ((last_l * vol) >> 9);
+		r = buf[i * 2 + 1] + ((last_r * vol) >> 9);
+
+		buf[i * 2] = (short) (l > 32767 ? 32767 : (l < -32768 ? -32768 : l));
+		buf[i * 2 + 1] =
+			(short) (r > 32767 ? 32767 : (r < -32768 ? -32768 : r));
+	}
+
+	if (cdda_eof && cdda_read == cdda_write)
+		cdda_state = CDDA_STOPPED;
+}
@@ -0,0 +1,35 @@
+#ifndef _CDDA_H_
+#define _CDDA_H_
+
+#include "cleantypes.h"
+
+//! Stereo frames buffered between the reader task and the mixer (64KB)
+#define CDDA_RING_FRAMES (16 * 1024)
+
+//! Bytes read from the track file at once by the reader task
+#define CDDA_CHUNK_SIZE (4 * 1024)
+
+//! Start the reader task and allocate the ring, does nothing if already done
+int cdda_init(void);
+
+//! Stop playing and close the current track file
+void cdda_shutdown(void);
+
+//! Play a whole audio track
+void cdda_play_track(uchar track, char repeat);
+
+//! Play from begin_lsn to end_lsn, both relative to 00:02:00
+void cdda_play_sectors(uint32 begin_lsn, uint32 end_lsn, char repeat);
+
+void cdda_pause(void);
+
+//! Resume a paused track, returns zero if there was nothing to resume
+int cdda_resume(void);
+
+//! Non zero if an audio track is currently playing
+int cdda_playing(void);
+
+//! Add the CD audio, resampled to rate and faded with cd_fade, to buf
+void cdda_mix(short *buf, int frames, int rate);
+
+#endif
@@ -14,6 +14,8 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 
+#include <string.h>
+
 #include "cheat.h"
 
 
@@ -30,31 +32,28 @@ fgetw(FILE * F)
 	return (uint16) (fgetc(F) + (fgetc(F) << 8));
 }
 
-freezed_value list_to_freeze[MAX_FREEZED_VALUE];
-// List of all the value to freeze
+PCE_LOCAL freezed_value list_to_freeze[MAX_FREEZED_VALUE];
+// List of all the value to freeze, sorted by position
 
-uchar current_freezed_values;
+PCE_LOCAL uchar current_freezed_values;
 // Current number of values to freeze
 
-static uchar
-bigindextobank(uint32 index)
-{
-	if (index < 0x8000)
-		return 0;
-	if (index < 0x18000)
-		return ((index - 0x8000) >> 13) + 1;
-	if (index < 0x48000)
-		return ((index - 0x18000) >> 13) + 10;
-	return 0;
-}
+// The search space is the RAM, then the CD RAM at 0x8000 and the Super CD
+// RAM at 0x18000. Its blocks are multiples of 8 bytes, so they are searched
+// 8 bytes at a time, each of them in a byte lane of a uint64.
+#define CHEAT_SPACE_SIZE (CD_emulation ? 0x48000 : 0x8000)
 
-uint16
-bigtosmallindex(uint32 index)
-{
-	if (index < 0x8000)
-		return (uint16) index;
-	return (uint16) (index & 0x1FFF);
-}
+#define CHEAT_HIGH 0x8080808080808080ULL
+#define CHEAT_LOW  0x0101010101010101ULL
+
+static PCE_LOCAL uint32 cheat_size;
+// Bytes searched, set by cheat_search_start
+
+static PCE_LOCAL uchar *cheat_candidates;
+// One bit per byte of the search space, set while it matches
+
+static PCE_LOCAL uchar *cheat_values;
+// Values of the search space at the previous search
 
 uchar
 readindexedram(uint32 index)
@@ -83,6 +82,272 @@ writeindexedram(uint32 index, uchar value)
 }
 
 
+//! Block of the search space holding index, and its bytes from index on
+static uchar *
+cheat_block(uint32 index, uint32 *size)
+{
+	if (index < 0x8000) {
+		*size = 0x8000 - index;
+		return RAM + index;
+	}
+	if (index < 0x18000) {
+		*size = 0x18000 - index;
+		return cd_extra_mem + index - 0x8000;
+	}
+	*size = 0x48000 - index;
+	return cd_extra_super_mem + index - 0x18000;
+}
+
+
+//! 8 bytes, the first one in the lowest lane
+static inline uint64
+cheat_load(const uchar *bytes)
+{
+	uint64 lanes;
+
+	memcpy(&lanes, bytes, sizeof(lanes));
+#if defined(WORDS_BIGENDIAN)
+	lanes = __builtin_bswap64(lanes);
+#endif
+	return lanes;
+}
+
+
+//! High bit of each lane set where the lanes of a and b are equal
+static inline uint64
+cheat_equal(uint64 a, uint64 b)
+{
+	uint64 difference = a ^ b;
+
+	return ~(((difference & ~CHEAT_HIGH) + ~CHEAT_HIGH) | difference)
+		& CHEAT_HIGH;
+}
+
+
+//! a + b in each lane, without carry between lanes
+static inline uint64
+cheat_add(uint64 a, uint64 b)
+{
+	return ((a & ~CHEAT_HIGH) + (b & ~CHEAT_HIGH)) ^ ((a ^ b) & CHEAT_HIGH);
+}
+
+
+//! a - b in each lane, without borrow between lanes
+static inline uint64
+cheat_sub(uint64 a, uint64 b)
+{
+	return ((a | CHEAT_HIGH) - (b & ~CHEAT_HIGH)) ^ ((a ^ ~b) & CHEAT_HIGH);
+}
+
+
+//! High bit of each lane set where the lane of a is below the one of b
+static inline uint64
+cheat_less(uint64 a, uint64 b)
+{
+	return ((~a & b) | (~(a ^ b) & cheat_sub(a, b))) & CHEAT_HIGH;
+}
+
+
+//! Gather the high bits of the lanes, lane n into bit n
+static inline uchar
+cheat_lanes_to_bits(uint64 lanes)
+{
+	return (uchar) (((lanes >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+
+void
+cheat_search_start(void)
+{
+	uint32 index, size;
+
+	cheat_search_stop();
+	cheat_size = CHEAT_SPACE_SIZE;
+	cheat_candidates = (uchar *) my_special_alloc(false, 1, cheat_size / 8);
+	cheat_values = (uchar *) my_special_alloc(false, 1, cheat_size);
+
+	memset(cheat_candidates, 0xFF, cheat_size / 8);
+	for (index = 0; index < cheat_size; index += size) {
+		uchar *memory = cheat_block(index, &size);
+
+		memcpy(cheat_values + index, memory, size);
+	}
+}
+
+
+uint32
+cheat_search(cheat_filter filter, uchar operand)
+{
+	uint64 operands = operand * CHEAT_LOW;
+	uint32 index, size, group, count = 0;
+
+	if (!cheat_candidates)
+		cheat_search_start();
+
+	for (index = 0; index < cheat_size; index += size) {
+		uchar *memory = cheat_block(index, &size);
+		uchar *candidates = cheat_candidates + index / 8;
+		uchar *values = cheat_values + index;
+
+		for (group = 0; group < size / 8; group++) {
+			uint64 now, before, match;
+
+			// Most of the space is ruled out after a search or two
+			if (!candidates[group])
+				continue;
+
+			now = cheat_load(memory + group * 8);
+			before = cheat_load(values + group * 8);
+
+			switch (filter) {
+			case CHEAT_EQUAL:
+				match = cheat_equal(now, operands);
+				break;
+			case CHEAT_NOT_EQUAL:
+				match = cheat_equal(now, operands) ^ CHEAT_HIGH;
+				break;
+			case CHEAT_LESS:
+				match = cheat_less(now, operands);
+				break;
+			case CHEAT_GREATER:
+				match = cheat_less(operands, now);
+				break;
+			case CHEAT_CHANGED:
+				match = cheat_equal(now, before) ^ CHEAT_HIGH;
+				break;
+			case CHEAT_UNCHANGED:
+				match = cheat_equal(now, before);
+				break;
+			case CHEAT_INCREASED:
+				match = cheat_less(before, now);
+				break;
+			case CHEAT_DECREASED:
+				match = cheat_less(now, before);
+				break;
+			case CHEAT_INCREASED_BY:
+				match = cheat_equal(now, cheat_add(before, operands));
+				break;
+			case CHEAT_DECREASED_BY:
+				match = cheat_equal(now, cheat_sub(before, operands));
+				break;
+			default:
+				match = 0;
+			}
+
+			candidates[group] &= cheat_lanes_to_bits(match);
+			count += __builtin_popcount(candidates[group]);
+			memcpy(values + group * 8, memory + group * 8, 8);
+		}
+	}
+
+	return count;
+}
+
+
+uint32
+cheat_search_next(uint32 index)
+{
+	if (!cheat_candidates)
+		return CHEAT_NONE;
+
+	while (index < cheat_size) {
+		uint32 bits = cheat_candidates[index / 8] >> (index & 7);
+
+		if (bits)
+			return index + __builtin_ctz(bits);
+		index = (index | 7) + 1;
+	}
+
+	return CHEAT_NONE;
+}
+
+
+void
+cheat_search_stop(void)
+{
+	free(cheat_candidates);
+	free(cheat_values);
+	cheat_candidates = NULL;
+	cheat_values = NULL;
+	cheat_size = 0;
+}
+
+
+//! Slot of position in list_to_freeze, or the one it would be inserted at
+static int
+cheat_freeze_slot(uint32 position)
+{
+	int low = 0, high = current_freezed_values;
+
+	while (low < high) {
+		int middle = (low + high) / 2;
+
+		if (list_to_freeze[middle].position < position)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+
+int
+cheat_freeze(uint32 position, uchar value)
+{
+	int slot = cheat_freeze_slot(position);
+
+	if (position >= CHEAT_SPACE_SIZE)
+		return 0;
+
+	if (slot == current_freezed_values
+		|| list_to_freeze[slot].position != position) {
+		if (current_freezed_values == MAX_FREEZED_VALUE)
+			return 0;
+
+		memmove(&list_to_freeze[slot + 1], &list_to_freeze[slot],
+			(current_freezed_values - slot) * sizeof(freezed_value));
+		current_freezed_values++;
+		list_to_freeze[slot].position = position;
+	}
+
+	list_to_freeze[slot].value = value;
+	return 1;
+}
+
+
+int
+cheat_unfreeze(uint32 position)
+{
+	int slot = cheat_freeze_slot(position);
+
+	if (slot == current_freezed_values
+		|| list_to_freeze[slot].position != position)
+		return 0;
+
+	current_freezed_values--;
+	memmove(&list_to_freeze[slot], &list_to_freeze[slot + 1],
+		(current_freezed_values - slot) * sizeof(freezed_value));
+	return 1;
+}
+
+
+void
+cheat_apply_freezes(void)
+{
+	freezed_value *freeze = list_to_freeze;
+	freezed_value *end = list_to_freeze + current_freezed_values;
+
+	// Sorted, so each block is a run of the table
+	for (; freeze < end && freeze->position < 0x8000; freeze++)
+		RAM[freeze->position] = freeze->value;
+	for (; freeze < end && freeze->position < 0x18000; freeze++)
+		cd_extra_mem[freeze->position - 0x8000] = freeze->value;
+	for (; freeze < end; freeze++)
+		cd_extra_super_mem[freeze->position - 0x18000] = freeze->value;
+}
+
+
 /*****************************************************************************
 
     Function: pokebyte
@@ -145,16 +410,9 @@ pokebyte()
 char
 searchbyte()
 {
-	uint32 MAX_INDEX;
 	char tmp_str[10];
-	uint32 index = 0, tmp_word, last_index;
-	uchar bank;
-	char data_filename[80], old_filename[80];
-	char first_research = 1;
-	FILE *D, *O;
-	Sint16 to_search;
-
-	MAX_INDEX = (uint16) (CD_emulation ? 0x48000 : 0x8000);
+	uint32 index = 0, count;
+	int to_search;
 
 	while (osd_keypressed())
 		/*@-retvalother */
@@ -167,115 +425,28 @@ searchbyte()
 
 	to_search = atoi(tmp_str);
 
-	strcpy(old_filename, short_cart_name);
-	strcpy(data_filename, short_cart_name);
-	strcat(data_filename, "FP1");
-
-	O = fopen((char *) strcat(old_filename, "FP0"), "rb");
-	if (O == NULL)
-		first_research = 1;
-/*  
-  if (exists ((char *) strcat (old_filename, "FP0")))
-    {
-      if (!(O = fopen (old_filename, "rb")))
-	return 1;
-      first_research = 0;
-    }
-*/
-	if (!(D = fopen(data_filename, "wb")))
-		return 1;
-	tmp_str[9] = 0;
-
-
 	if ((tmp_str[0] != '-')
 		&& (tmp_str[0] != '+')) {	/* non relative research */
-
-		for (index = 0; index < MAX_INDEX; index++) {
-			if (readindexedram(index) == (uchar) to_search) {
-
-				if (first_research) {
-					fputc(readindexedram(index), D);
-					fputc(bigindextobank(index), D);
-					fputw(bigtosmallindex(index), D);
-				} else {
-					while (!(feof(O))) {
-						fgetc(O);
-						bank = (uchar) fgetc(O);
-						tmp_word = fgetw(O);
-
-						if ((bank > bigindextobank(index))
-							||
-							((bank == bigindextobank(index))
-							 && (tmp_word >= bigtosmallindex(index)))) {
-							fseek(O, -4, SEEK_CUR);
-							break;
-						}
-					}
-
-					if ((bigtosmallindex(index) == (uint16) tmp_word) &&
-						(bigindextobank(index) == bank)) {
-						fputc(to_search, D);
-						fputc(bigindextobank(index), D);
-						fputw(bigtosmallindex(index), D);
-						last_index = index;
-					}
-				}				//search for old occurences
-			}
-		}
-	} else {					/* relative research */
-		for (index = 0; index < MAX_INDEX; index++) {
-
-			if (first_research) {
-				fputc(readindexedram(index), D);
-				fputc(bigindextobank(index), D);
-				fputw(bigtosmallindex(index), D);
-			} else {
-				uchar old_value;
-
-				{
-					while (!(feof(O))) {
-						fgetc(O);
-						bank = (uchar) fgetc(O);
-						tmp_word = fgetw(O);
-
-						if ((bank > bigindextobank(index))
-							||
-							((bank == bigindextobank(index))
-							 && (tmp_word >= bigtosmallindex(index)))) {
-							fseek(O, -4, SEEK_CUR);
-							break;
-						}
-					}
-
-					if ((bigindextobank(index) == bank) &&
-						(bigtosmallindex(index) == (uint16) tmp_word) &&
-						(readindexedram(index) == old_value + to_search)) {
-						fputc(readindexedram(index), D);
-						fputc(bigindextobank(index), D);
-						fputw(bigtosmallindex(index), D);
-						last_index = index;
-					}
-				}				//search for old occurences
-			}
-		}
-
-	}
-
-	if (!first_research)
-		fclose(O);
-	fclose(D);
-
-	rename(data_filename, old_filename);
-	if (!file_size(old_filename)) {
+		count = cheat_search(CHEAT_EQUAL, (uchar) to_search);
+	} else if (!cheat_candidates) {	/* relative research */
+		// Only the values to compare the next search with
+		cheat_search_start();
+		count = cheat_size;
+	} else if (to_search >= 0)
+		count = cheat_search(CHEAT_INCREASED_BY, (uchar) to_search);
+	else
+		count = cheat_search(CHEAT_DECREASED_BY, (uchar) -to_search);
+
+	if (!count) {
 		osd_gfx_set_message("Search failed");
 		message_delay = 180;
-		unlink(old_filename);
+		cheat_search_stop();
 		return 1;
 	}
 
-	if (file_size(old_filename) == 4) {
+	if (count == 1) {
 		char *tmp_buf = (char *) malloc(100);
-		snprintf(tmp_buf, 100, "Found at %d", last_index);
+		snprintf(tmp_buf, 100, "Found at %d", cheat_search_next(0));
 		osd_gfx_set_message(tmp_buf);
 		message_delay = 60 * 5;
 		free(tmp_buf);
@@ -393,34 +564,17 @@ freeze_value(void)
 
 	where = (unsigned) atoi(tmp_str);
 
-	for (index = 0; index < current_freezed_values; index++)
-		if (list_to_freeze[index].position == (unsigned short) where) {
-			// We entered an already freezed offset
-
-			memcpy(&list_to_freeze[index], &list_to_freeze[index + 1],
-				   (current_freezed_values - index +
-					1) * sizeof(freezed_value));
-			// We erase the current struct letting no hole...
-
-			current_freezed_values--;
-			// And we got one less value
-
-			return 0;
-		}
-
-	if (current_freezed_values < MAX_FREEZED_VALUE) {
-		list_to_freeze[current_freezed_values].position =
-			(unsigned short) where;
+	// We entered an already freezed offset
+	if (cheat_unfreeze(where))
+		return 0;
 
-		while ((index < 10)
-			   && ((tmp_str[index++] = (char) (osd_readkey() & 0xFF)) !=
-				   13));
-		tmp_str[index - 1] = 0;
+	if (current_freezed_values == MAX_FREEZED_VALUE)
+		return 0;
 
-		list_to_freeze[current_freezed_values++].value =
-			(unsigned) atoi(tmp_str);
+	index = 0;
+	while ((index < 10)
+		   && ((tmp_str[index++] = (char) (osd_readkey() & 0xFF)) != 13));
+	tmp_str[index - 1] = 0;
 
-		return 1;
-	} else
-		return 0;
+	return cheat_freeze(where, (uchar) atoi(tmp_str));
 }
@@ -21,19 +21,61 @@ int loadgame();
 int savegame();
 /* Save the progression */
 
-#define  MAX_FREEZED_VALUE   8
+#define  MAX_FREEZED_VALUE   64
 
 typedef struct {
-	unsigned short position;
+	uint32 position;
 	uchar value;
 } freezed_value;
 
-extern freezed_value list_to_freeze[MAX_FREEZED_VALUE];
-/* List of all the value to freeze */
+extern PCE_LOCAL freezed_value list_to_freeze[MAX_FREEZED_VALUE];
+/* List of all the value to freeze, sorted by position */
 
-extern uchar current_freezed_values;
+extern PCE_LOCAL uchar current_freezed_values;
 /* Current number of values to freeze */
 
 int freeze_value(void);
 
+int cheat_freeze(uint32 position, uchar value);
+/* Freeze the byte at position of the search space to value, replacing its
+   former value if already frozen. Return 0 if the table is full */
+
+int cheat_unfreeze(uint32 position);
+/* Return 0 if the byte wasn't frozen */
+
+void cheat_apply_freezes(void);
+/* Write the frozen values, once per frame */
+
+#define cheat_frame() { if (current_freezed_values) cheat_apply_freezes(); }
+
+/* Relations kept by cheat_search, between the value of each candidate and
+   the operand, or its value at the previous search */
+typedef enum {
+	CHEAT_EQUAL,
+	CHEAT_NOT_EQUAL,
+	CHEAT_LESS,
+	CHEAT_GREATER,
+	CHEAT_CHANGED,
+	CHEAT_UNCHANGED,
+	CHEAT_INCREASED,
+	CHEAT_DECREASED,
+	CHEAT_INCREASED_BY,
+	CHEAT_DECREASED_BY
+} cheat_filter;
+
+#define CHEAT_NONE 0xFFFFFFFF
+
+void cheat_search_start(void);
+/* Make every byte of the RAM, and of the CD RAM if any, a candidate, and
+   take their values for the relative filters */
+
+uint32 cheat_search(cheat_filter filter, uchar operand);
+/* Keep the candidates matching filter, return how many are left */
+
+uint32 cheat_search_next(uint32 index);
+/* First candidate at index or after, CHEAT_NONE if none */
+
+void cheat_search_stop(void);
+/* Free the candidates */
+
 #endif
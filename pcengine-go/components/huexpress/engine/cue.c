@@ -0,0 +1,252 @@
+/***************************************************************************/
+/*                                                                         */
+/*                         Cue sheet Source File                           */
+/*                                                                         */
+/*     Reads the track layout of BIN images from their cue sheet, so the   */
+/*     data track is found without scanning the image. Both single file    */
+/*     and one file per track sheets are handled.                          */
+/*                                                                         */
+/***************************************************************************/
+
+#include "cue.h"
+#include "pce.h"
+
+#include <string.h>
+#include <strings.h>
+
+//! Bytes before the user data in a raw sector (sync, header, subheader)
+#define CUE_MODE1_HEADER 16
+#define CUE_MODE2_HEADER 24
+
+#define CUE_LINE_LENGTH 512
+
+
+//! Parse "mm:ss:ff" into a number of frames
+static int
+cue_get_time(char *text, uint32 * frames)
+{
+	int min, sec, fra;
+
+	if (sscanf(text, "%d:%d:%d", &min, &sec, &fra) != 3)
+		return 0;
+
+	*frames = (min * CD_SECS + sec) * CD_FRAMES + fra;
+	return 1;
+}
+
+
+//! Copy the file name of a FILE line, relative to the cue sheet directory
+static int
+cue_get_filename(char *cue_name, char *text, char *result)
+{
+	char *begin, *end, *slash;
+
+	begin = strchr(text, '"');
+	if (begin) {
+		end = strchr(++begin, '"');
+	} else {
+		begin = text;
+		while (*begin == ' ' || *begin == '\t')
+			begin++;
+		end = strpbrk(begin, " \t\r\n");
+	}
+
+	if (!end || end == begin)
+		return 0;
+
+	slash = strrchr(cue_name, '/');
+	if (slash && *begin != '/')
+		snprintf(result, 256, "%.*s%.*s", (int) (slash + 1 - cue_name),
+				 cue_name, (int) (end - begin), begin);
+	else
+		snprintf(result, 256, "%.*s", (int) (end - begin), begin);
+
+	return 1;
+}
+
+
+#define CUE_FILE_BINARY 1
+#define CUE_FILE_WAVE 2
+
+//! Type of a FILE line, 0 for the ones that can't be read (MP3, AIFF...)
+static int
+cue_file_type(char *text)
+{
+	char *end = text + strlen(text);
+	char *type;
+
+	while (end > text && strchr(" \t\r\n", end[-1]))
+		end--;
+	type = end;
+	while (type > text && !strchr(" \t\"", type[-1]))
+		type--;
+
+	if (end - type == 6 && !strncasecmp(type, "BINARY", 6))
+		return CUE_FILE_BINARY;
+	if (end - type == 4 && !strncasecmp(type, "WAVE", 4))
+		return CUE_FILE_WAVE;
+
+	MESSAGE_ERROR("CUE: file type %.*s not supported\n", (int) (end - type),
+				  type);
+	return 0;
+}
+
+
+static uint32
+cue_file_sectors(char *filename, int sector_size)
+{
+	FILE *f = fopen(filename, "rb");
+	uint32 sectors = 0;
+
+	if (f) {
+		sectors = filesize(f) / sector_size;
+		fclose(f);
+	} else
+		MESSAGE_ERROR("CUE: couldn't open %s\n", filename);
+
+	return sectors;
+}
+
+
+int
+fill_CUE_info(char *name)
+{
+	static char line[CUE_LINE_LENGTH];
+	char filename[256] = "";
+	char *keyword;
+	FILE *cue;
+	int track = 0, last_track_in_file = 0, number, index, file_type = 0;
+	uint32 file_lsn = 0, pregap = 0, frames;
+	uchar min, sec, fra;
+
+	if (!(cue = fopen(name, "rt")))
+		return 0;
+
+	memset(CD_track, 0, sizeof(Track) * 0x100);
+
+	while (fgets(line, CUE_LINE_LENGTH, cue)) {
+		keyword = line;
+		while (*keyword == ' ' || *keyword == '\t')
+			keyword++;
+
+		if (!strncasecmp(keyword, "FILE", 4)) {
+			// Close the last track of the previous file
+			if (last_track_in_file) {
+				file_lsn += cue_file_sectors(filename,
+											 CD_track[last_track_in_file].
+											 sector_size);
+				CD_track[last_track_in_file].length =
+					file_lsn + pregap - CD_track[last_track_in_file].beg_lsn;
+				last_track_in_file = 0;
+			}
+
+			// The game can't run with a track it can't play
+			if (!cue_get_filename(name, keyword + 4, filename)
+				|| !(file_type = cue_file_type(keyword + 4)))
+				goto bad_cue;
+		} else if (!strncasecmp(keyword, "TRACK", 5)) {
+			char type[32];
+
+			if (sscanf(keyword + 5, "%d %31s", &number, type) != 2
+				|| number <= track || number > 99)
+				goto bad_cue;
+
+			track = number;
+			strcpy(CD_track[track].filename, filename);
+			CD_track[track].source_type = HCD_SOURCE_REGULAR_FILE;
+
+			if (!strcasecmp(type, "AUDIO")) {
+				CD_track[track].type = 0;
+				CD_track[track].sector_size = 2352;
+			} else if (file_type == CUE_FILE_WAVE) {
+				MESSAGE_ERROR("CUE: track %d is data in a WAVE file\n", track);
+				goto bad_cue;
+			} else {
+				CD_track[track].type = 4;
+				if (!strcasecmp(type, "MODE1/2048")) {
+					CD_track[track].sector_size = 2048;
+				} else if (!strcasecmp(type, "MODE1/2352")) {
+					CD_track[track].sector_size = 2352;
+					CD_track[track].file_offset = CUE_MODE1_HEADER;
+				} else if (!strcasecmp(type, "MODE2/2352")) {
+					CD_track[track].sector_size = 2352;
+					CD_track[track].file_offset = CUE_MODE2_HEADER;
+				} else {
+					MESSAGE_ERROR("CUE: track type %s not supported\n", type);
+					goto bad_cue;
+				}
+			}
+		} else if (!strncasecmp(keyword, "PREGAP", 6)) {
+			// Silence not stored in the file
+			if (track && cue_get_time(keyword + 6, &frames))
+				pregap += frames;
+		} else if (!strncasecmp(keyword, "INDEX", 5)) {
+			char time[32];
+
+			if (!track || sscanf(keyword + 5, "%d %31s", &index, time) != 2
+				|| !cue_get_time(time, &frames) || index != 1)
+				continue;
+
+			// The previous track ends where this one begins
+			if (last_track_in_file)
+				CD_track[last_track_in_file].length = file_lsn + pregap
+					+ frames - CD_track[last_track_in_file].beg_lsn;
+
+			CD_track[track].beg_lsn = file_lsn + pregap + frames;
+			CD_track[track].file_offset +=
+				frames * CD_track[track].sector_size;
+			last_track_in_file = track;
+
+			nb_sect2msf(CD_track[track].beg_lsn + 150, &min, &sec, &fra);
+			CD_track[track].beg_min = binbcd[min];
+			CD_track[track].beg_sec = binbcd[sec];
+			CD_track[track].beg_fra = binbcd[fra];
+		}
+	}
+
+	if (last_track_in_file) {
+		file_lsn += cue_file_sectors(filename,
+									 CD_track[last_track_in_file].sector_size);
+		CD_track[last_track_in_file].length =
+			file_lsn + pregap - CD_track[last_track_in_file].beg_lsn;
+	}
+
+	fclose(cue);
+
+	if (track < 2 || CD_track[2].type != 4 || !CD_track[2].length) {
+		MESSAGE_ERROR("CUE: %s has no data track 2\n", name);
+		return -1;
+	}
+
+	nb_max_track = track;
+
+	MESSAGE_INFO("CUE: %d tracks, data track in %s at offset %d\n",
+				 nb_max_track, CD_track[2].filename, CD_track[2].file_offset);
+	return 1;
+
+  bad_cue:
+	fclose(cue);
+	MESSAGE_ERROR("CUE: couldn't parse %s: %s", name, line);
+	return -1;
+}
+
+
+int
+search_CUE_info(char *bin_name)
+{
+	char cue_name[256];
+	char *extension = strrchr(bin_name, '.');
+	int result;
+
+	if (!extension)
+		return 0;
+
+	snprintf(cue_name, sizeof(cue_name), "%.*s.cue",
+			 (int) (extension - bin_name), bin_name);
+	if ((result = fill_CUE_info(cue_name)))
+		return result;
+
+	snprintf(cue_name, sizeof(cue_name), "%.*s.CUE",
+			 (int) (extension - bin_name), bin_name);
+	return fill_CUE_info(cue_name);
+}
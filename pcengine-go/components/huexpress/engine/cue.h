@@ -0,0 +1,12 @@
+#ifndef _CUE_H_
+#define _CUE_H_
+
+//! Fill CD_track and nb_max_track from a cue sheet, returns 0 if it can't
+//! be opened and -1 if it is invalid or has no data track
+int fill_CUE_info(char *name);
+
+//! Look for a cue sheet named after a BIN image, returns 0 if none was found
+//! and -1 if the one found is invalid
+int search_CUE_info(char *bin_name);
+
+#endif
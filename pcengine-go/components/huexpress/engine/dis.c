@@ -449,4 +449,12 @@ disassemble()
 	return (0);					/* return value to appease compiler */
 }
 
+#else
+
+int
+disassemble()
+{
+	return 0;
+}
+
 #endif
@@ -23,6 +23,7 @@
 
 
 #include "pce.h"
+#include "pcecd.h"
 #include "utils.h"
 #include "config.h"
 
@@ -200,16 +201,16 @@ change_pce_screen_height()
 	(*osd_gfx_driver_list[video_driver].mode) ();
 }
 
-gfx_context saved_gfx_context[MAX_GFX_CONTEXT_SLOT_NUMBER];
+PCE_LOCAL gfx_context saved_gfx_context[MAX_GFX_CONTEXT_SLOT_NUMBER];
 
 //! Whether we need to draw pending lines
-int gfx_need_redraw;
+PCE_LOCAL int gfx_need_redraw;
 
 //! Frame to skip before the next frame to render
-int UCount = 0;
+PCE_LOCAL int UCount = 0;
 
 //! Whether we should change video mode after drawing the current frame
-int gfx_need_video_mode_change = 0;
+PCE_LOCAL int gfx_need_video_mode_change = 0;
 
 #ifndef MY_INLINE_GFX
 
@@ -348,6 +349,12 @@ render_lines(int min_line, int max_line)
 
 #ifndef MY_INLINE_GFX_Loop6502
 
+//! Frame state of Loop6502, part of the console state
+PCE_LOCAL int video_dump_countdown = 0;
+PCE_LOCAL int display_counter = 0;
+PCE_LOCAL int last_display_counter = 0;
+PCE_LOCAL int satb_dma_counter = 0;
+
 //! Rewritten version of Loop6502 from scratch, called when each line drawing should occur
 /* TODO:
 	 - sprite #0 collision checking (occur as soon as the sprite #0 is shown and overlap another sprite
@@ -357,14 +364,15 @@ inline uchar
 Loop6502()
 {
     ODROID_DEBUG_PERF_START2(debug_perf_part1)
-	static int video_dump_countdown = 0;
-	static int display_counter = 0;
-	static int last_display_counter = 0;
-	static int satb_dma_counter = 0;
 	uchar return_value = INT_NONE;
+	uchar cd_interrupt = INT_NONE;
 
 	io.vdc_status &= ~(VDC_RasHit | VDC_SATBfinish);
 
+	// The CD drive delivers its sectors on its own schedule
+	if (pce_cd_drive_busy)
+		cd_interrupt = pce_cd_drive_tick();
+
 	// Count dma delay
 
 	if (satb_dma_counter > 0) {
@@ -467,7 +475,9 @@ Loop6502()
 			    ODROID_DEBUG_PERF_INCR2(debug_perf_part1, ODROID_DEBUG_PERF_LOOP6502)
 				return INT_QUIT;
             }
-			if (!UCount)
+			movie_frame();
+			cheat_frame();
+			if (!UCount && !movie_max_speed())
 				RefreshScreen();
 
 			/*@-preproc */
@@ -478,7 +488,9 @@ Loop6502()
 			else
 				io.vdc_status &= ~VDC_SpHit;
 
-			if (!UCount) {
+			if (movie_max_speed()) {
+				// Benchmarks run as fast as the emulation goes
+			} else if (!UCount) {
 #if defined(ENABLE_NETPLAY)
 				if (option.want_netplay != INTERNET_PROTOCOL) {
 					/* When in internet protocol mode, it's the server which is in charge of throlling */
@@ -541,7 +553,7 @@ Loop6502()
 		}
 	}
     ODROID_DEBUG_PERF_INCR2(debug_perf_part1, ODROID_DEBUG_PERF_LOOP6502)
-	return INT_NONE;
+	return cd_interrupt;
 }
 #else
 /*
@@ -60,7 +60,7 @@ typedef struct {
 //extern SDL_Color olay_cmap[256];
 
 extern int video_dump_flag;
-extern int gfx_need_video_mode_change;
+extern PCE_LOCAL int gfx_need_video_mode_change;
 
 void calc_fullscreen_aspect(unsigned short physical_screen_width,
 							unsigned short physical_screen_height,
@@ -70,7 +70,7 @@ void calc_fullscreen_aspect(unsigned short physical_screen_width,
 void change_pce_screen_height();
 
 #define MAX_GFX_CONTEXT_SLOT_NUMBER 2
-extern gfx_context saved_gfx_context[MAX_GFX_CONTEXT_SLOT_NUMBER];
+extern PCE_LOCAL gfx_context saved_gfx_context[MAX_GFX_CONTEXT_SLOT_NUMBER];
 
 void save_gfx_context_(int slot_number);
 // void load_gfx_context_(int slot_number);
@@ -133,8 +133,8 @@ void dump_video_frame();
 
 void dump_rgb_frame(char *output_buffer);
 
-extern int UCount;
-extern int gfx_need_redraw;
+extern PCE_LOCAL int UCount;
+extern PCE_LOCAL int gfx_need_redraw;
 
 #ifdef MY_INLINE_GFX_Loop6502
 #define GFX_Loop6502_Init \
@@ -147,6 +147,11 @@ extern int gfx_need_redraw;
 #else
 #define GFX_Loop6502_Init
 uchar Loop6502();
+
+extern PCE_LOCAL int video_dump_countdown;
+extern PCE_LOCAL int display_counter;
+extern PCE_LOCAL int last_display_counter;
+extern PCE_LOCAL int satb_dma_counter;
 #endif
 
 #if ENABLE_TRACING_GFX
@@ -1,8 +1,13 @@
     ODROID_DEBUG_PERF_START2(debug_perf_part_loop6502)
     uchar return_value = INT_NONE;
+    uchar cd_interrupt = INT_NONE;
 
     io.vdc_status &= ~(VDC_RasHit | VDC_SATBfinish);
 
+    // The CD drive delivers its sectors on its own schedule
+    if (pce_cd_drive_busy)
+        cd_interrupt = pce_cd_drive_tick();
+
     // Count dma delay
 
     if (satb_dma_counter > 0) {
@@ -118,8 +123,26 @@
                 change_pce_screen_height();
             }
 
-            osd_keyboard();
-            if (!UCount)
+            // Host tools stop the emulation between two frames
+            if (!rollback_silent()) {
+                if (osd_keyboard())
+                    return;
+                movie_frame();
+            }
+#ifdef MY_NETPLAY_ROLLBACK
+#ifndef MY_h6280_INT_cycle_counter
+            // The timer phase is saved with the snapshots as a single value
+            CycleNew -= cyclecountold;
+            cyclecountold = 0;
+#endif
+            if (rollback_frame(&CycleNew))
+                // Interrupts of this line, from the restored state
+                return_value = (io.vdc_status & (VDC_RasHit | VDC_SATBfinish))
+                    ? INT_IRQ : INT_NONE;
+#endif
+            // Once per frame, after any rollback, before the game reads them
+            cheat_frame();
+            if (!UCount && !movie_max_speed() && !rollback_silent())
             {
                 ODROID_DEBUG_PERF_START2(debug_perf_refreshscreen)
                 RefreshScreen();
@@ -160,7 +183,9 @@ jump_CheckSprites:
             else
                 io.vdc_status &= ~VDC_SpHit;
 #endif
-            if (!UCount) {
+            if (movie_max_speed() || rollback_silent()) {
+                // Benchmarks and rollbacks run as fast as the emulation goes
+            } else if (!UCount) {
 #if defined(ENABLE_NETPLAY)
                 if (option.want_netplay != INTERNET_PROTOCOL) {
                     /* When in internet protocol mode, it's the server which is in charge of throlling */
@@ -219,6 +244,6 @@ jump_CheckSprites:
         if (!(io.irq_mask & IRQ1)) {
             io.irq_status |= IRQ1;
             I = return_value;
-        } else I = INT_NONE;
-    } else I = INT_NONE;
+        } else I = cd_interrupt;
+    } else I = cd_interrupt;
     ODROID_DEBUG_PERF_INCR2(debug_perf_part_loop6502, ODROID_DEBUG_PERF_LOOP6502)
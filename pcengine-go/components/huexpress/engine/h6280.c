@@ -10,6 +10,7 @@
 #include "hard_pce.h"
 #include "gfx.h"
 #include "pce.h"
+#include "pcecd.h"
 #include "utils.h"
 
 #ifdef MY_INLINE_IO_ReadWrite
@@ -285,7 +286,7 @@ push_16bit_(uint16 addr)
 	return;
 }
 
-inline uint16
+static inline uint16
 pull_16bit_(void)
 {
 	uint16 n = (uchar) * (sp_base + ++reg_s);
@@ -628,6 +629,7 @@ exe_go(void)
 
 		// HSYNC stuff - count cycles:
 		if (cycles > 455) {
+			profile_sample();
 
 #ifdef BENCHMARK
 			countScan++;
@@ -655,6 +657,7 @@ exe_go(void)
 			// scanline++;
 
 			// Log("Calling periodic handler\n");
+			ODROID_TRACE_BEGIN(ODROID_TRACE_LOOP6502)
 #ifdef MY_INLINE_GFX_Loop6502
 {
             #include "gfx_Loop6502.h"
@@ -663,6 +666,7 @@ exe_go(void)
 #else
 			I = Loop6502();		/* Call the periodic handler */
 #endif
+			ODROID_TRACE_END(ODROID_TRACE_LOOP6502)
             ODROID_DEBUG_PERF_START2(debug_perf_int)
 			// _ICount += _IPeriod;
 			/* Reset the cycle counter */
@@ -38,6 +38,7 @@ exe_go(void)
       ODROID_DEBUG_PERF_START2(debug_perf_total)
 
       ODROID_DEBUG_PERF_START2(debug_perf_part1)
+      ODROID_TRACE_BEGIN(ODROID_TRACE_CPU)
       while (cycles<=455)
       {
 #ifdef USE_INSTR_SWITCH
@@ -46,11 +47,13 @@ exe_go(void)
         /*err =*/ (*optable_runtime[PageR[reg_pc >> 13][reg_pc]].func_exe) ();
 #endif
       }
+      ODROID_TRACE_END(ODROID_TRACE_CPU)
 
       ODROID_DEBUG_PERF_INCR2(debug_perf_part1, ODROID_DEBUG_PERF_CPU)
 
         // HSYNC stuff - count cycles:
         /*if (cycles > 455) */ {
+            profile_sample();
 #ifdef BENCHMARK
             countScan++;
             if ((countScan & 0xFFFF) == 0) {
@@ -72,6 +75,7 @@ exe_go(void)
             // scanline++;
 
             // Log("Calling periodic handler\n");
+            ODROID_TRACE_BEGIN(ODROID_TRACE_LOOP6502)
 #ifdef MY_INLINE_GFX_Loop6502
 {
             #include "gfx_Loop6502.h"
@@ -80,6 +84,7 @@ exe_go(void)
 #else
             I = Loop6502();     /* Call the periodic handler */
 #endif
+            ODROID_TRACE_END(ODROID_TRACE_LOOP6502)
             ODROID_DEBUG_PERF_START2(debug_perf_int)
             // _ICount += _IPeriod;
             /* Reset the cycle counter */
@@ -87,7 +92,8 @@ exe_go(void)
 
             // Log("Requested interrupt is %d\n",I);
 
-            /* if (I == INT_QUIT) return; */
+            if (I == INT_QUIT)
+                return;         /* Exit if INT_QUIT */
 
             if (I)
                 Int6502(I);     /* Interrupt if needed  */
@@ -74,6 +74,7 @@ exe_go(void)
       ODROID_DEBUG_PERF_START2(debug_perf_total)
 
       ODROID_DEBUG_PERF_START2(debug_perf_part1)
+      ODROID_TRACE_BEGIN(ODROID_TRACE_CPU)
       while (cycles<=455)
       {
 #ifdef USE_INSTR_SWITCH
@@ -82,6 +83,7 @@ exe_go(void)
         /*err =*/ (*optable_runtime[PageR[reg_pc >> 13][reg_pc]].func_exe) ();
 #endif
       }
+      ODROID_TRACE_END(ODROID_TRACE_CPU)
 
       ODROID_DEBUG_PERF_INCR2(debug_perf_part1, ODROID_DEBUG_PERF_CPU)
 
@@ -89,6 +91,7 @@ exe_go(void)
 
         // HSYNC stuff - count cycles:
         /*if (cycles > 455) */ {
+            profile_sample();
 
             CycleNew += cycles;
             // cycles -= 455;
@@ -2,6 +2,7 @@
 #ifdef ODROID_DEBUG_PERF_CPU_ALL_INSTR
          ODROID_DEBUG_PERF_START()
 #endif
+    opcode_stats_start()
     ODROID_DEBUG_PERF_START2(my_perf_mem_access)
     uint8_t cmd = PageR[reg_pc >> 13][reg_pc];
     ODROID_DEBUG_PERF_INCR2(my_perf_mem_access, ODROID_DEBUG_PERF_MEM_ACCESS1)
@@ -30,9 +31,9 @@
     
 #ifdef MY_LOG_CPU_NOT_INLINED
 static _used[256];
-#define OP_CALL_THROUGH_LOOKUP (*optable_runtime[cmd].func_exe) (); if (_used[cmd] != 77) { printf("HMM: 0x%2X\n", cmd); _used[cmd] = 77; }
+#define OP_CALL_THROUGH_LOOKUP (*optable_runtime[cmd].func_exe) (); opcode_stats_mark_lookup(cmd) if (_used[cmd] != 77) { printf("HMM: 0x%2X\n", cmd); _used[cmd] = 77; }
 #else
-#define OP_CALL_THROUGH_LOOKUP (*optable_runtime[cmd].func_exe) ();
+#define OP_CALL_THROUGH_LOOKUP (*optable_runtime[cmd].func_exe) (); opcode_stats_mark_lookup(cmd)
 #endif
     switch (cmd)
     {
@@ -239,9 +240,17 @@ static _used[256];
     case 0x20: // aaaa
         // {jsr, AM_ABS, "JSR"}
         reg_p &= ~FL_T;
-        push_16bit(reg_pc + 2);
-        reg_pc = get_16bit_addr(reg_pc + 1);
+        {
+        uint16 target = get_16bit_addr(reg_pc + 1);
+        // CD_READ done at the call returns right away
+        if (target == CD_BIOS_READ && pce_cd_bios_read())
+            reg_pc += 3;
+        else {
+            push_16bit(reg_pc + 2);
+            reg_pc = target;
+        }
         cycles += 7;
+        } 
         break;
     case 0x21:
         // {and_zpindx, AM_ZPINDX, "AND"}
@@ -1441,6 +1450,7 @@ static _used[256];
         _OPCODE_bbs_(0x80) 
         break;
    }
+   opcode_stats_end(cmd)
 #ifdef ODROID_DEBUG_PERF_CPU_ALL_INSTR
          ODROID_DEBUG_PERF_INCR(0x0100 + (uint16_t)cmd)
 #endif
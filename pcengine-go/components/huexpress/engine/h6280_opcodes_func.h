@@ -1564,9 +1564,16 @@ jmp_absindx(void)
 int
 jsr(void)
 {
+    uint16 target = get_16bit_addr(reg_pc + 1);
+
     reg_p &= ~FL_T;
-    push_16bit(reg_pc + 2);
-    reg_pc = get_16bit_addr(reg_pc + 1);
+    // CD_READ done at the call returns right away
+    if (target == CD_BIOS_READ && pce_cd_bios_read())
+        reg_pc += 3;
+    else {
+        push_16bit(reg_pc + 2);
+        reg_pc = target;
+    }
     cycles += 7;
     return 0;
 }
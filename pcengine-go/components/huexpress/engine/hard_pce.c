@@ -37,47 +37,47 @@
   * cf explanations in the header file
   **/
 
-struct_hard_pce *hard_pce;
+PCE_LOCAL struct_hard_pce *hard_pce;
 
-uchar *RAM;
+PCE_LOCAL uchar *RAM;
 
 // Video
-uint16 *SPRAM;
-uchar *VRAM2;
-uchar *VRAMS;
-uchar *Pal;
-uchar *vchange;
-uchar *vchanges;
-uchar *WRAM;
-uchar *VRAM;
-uint32 *p_scanline;
+PCE_LOCAL uint16 *SPRAM;
+PCE_LOCAL uchar *VRAM2;
+PCE_LOCAL uchar *VRAMS;
+PCE_LOCAL uchar *Pal;
+PCE_LOCAL uchar *vchange;
+PCE_LOCAL uchar *vchanges;
+PCE_LOCAL uchar *WRAM;
+PCE_LOCAL uchar *VRAM;
+PCE_LOCAL uint32 *p_scanline;
 
 // Audio
-uchar *PCM;
+PCE_LOCAL uchar *PCM;
 
 // I/O
-IO *p_io;
+PCE_LOCAL IO *p_io;
 
 // CD
- /**/ uchar * cd_read_buffer;
-uchar *cd_sector_buffer;
-uchar *cd_extra_mem;
-uchar *cd_extra_super_mem;
-uchar *ac_extra_mem;
-
-uint32 pce_cd_read_datacnt;
- /**/ uchar cd_sectorcnt;
-uchar pce_cd_curcmd;
+ /**/ PCE_LOCAL uchar * cd_read_buffer;
+PCE_LOCAL uchar *cd_sector_buffer;
+PCE_LOCAL uchar *cd_extra_mem;
+PCE_LOCAL uchar *cd_extra_super_mem;
+PCE_LOCAL uchar *ac_extra_mem;
+
+PCE_LOCAL uint32 pce_cd_read_datacnt;
+ /**/ PCE_LOCAL uchar cd_sectorcnt;
+PCE_LOCAL uchar pce_cd_curcmd;
  /**/
 // Memory
-	uchar * zp_base;
-uchar *sp_base;
-uchar *mmr;
-uchar *IOAREA;
+	PCE_LOCAL uchar * zp_base;
+PCE_LOCAL uchar *sp_base;
+PCE_LOCAL uchar *mmr;
+PCE_LOCAL uchar *IOAREA;
 
 // Interruption
-uint32 *p_cyclecount;
-uint32 *p_cyclecountold;
+PCE_LOCAL uint32 *p_cyclecount;
+PCE_LOCAL uint32 *p_cyclecountold;
 
 //const uint32 TimerPeriod = 1097;
 
@@ -88,64 +88,46 @@ uint32 *p_cyclecountold;
 //! Shared memory handle
 static int shm_handle;
 
-uint16 *p_reg_pc;
-uchar *p_reg_a;
-uchar *p_reg_x;
-uchar *p_reg_y;
-uchar *p_reg_p;
-uchar *p_reg_s;
+PCE_LOCAL uint16 *p_reg_pc;
+PCE_LOCAL uchar *p_reg_a;
+PCE_LOCAL uchar *p_reg_x;
+PCE_LOCAL uchar *p_reg_y;
+PCE_LOCAL uchar *p_reg_p;
+PCE_LOCAL uchar *p_reg_s;
 
 #else
 
-DRAM_ATTR uint32 reg_pc_;
-DRAM_ATTR uchar reg_a_;
-DRAM_ATTR uchar reg_x_;
-DRAM_ATTR uchar reg_y_;
-DRAM_ATTR uchar reg_p_;
-DRAM_ATTR uchar reg_s_;
+DRAM_ATTR PCE_LOCAL uint32 reg_pc_;
+DRAM_ATTR PCE_LOCAL uchar reg_a_;
+DRAM_ATTR PCE_LOCAL uchar reg_x_;
+DRAM_ATTR PCE_LOCAL uchar reg_y_;
+DRAM_ATTR PCE_LOCAL uchar reg_p_;
+DRAM_ATTR PCE_LOCAL uchar reg_s_;
 
 #endif
 
 // Mapping
 //uchar *PageR[8];
 // IRAM_ATTR slower
-uchar **PageR;
-uchar *ROMMapR[256];
+PCE_LOCAL uchar **PageR;
+PCE_LOCAL uchar *ROMMapR[256];
 //uchar **ROMMapR;
 
 //uchar *PageW[8];
-uchar **PageW;
-uchar *ROMMapW[256];
+PCE_LOCAL uchar **PageW;
+PCE_LOCAL uchar *ROMMapW[256];
 //uchar **ROMMapW;
 
-uchar *trap_ram_read;
-uchar *trap_ram_write;
+PCE_LOCAL uchar *trap_ram_read;
+PCE_LOCAL uchar *trap_ram_write;
 
 // Miscellaneous
 //DRAM_ATTR uint32 *p_cycles;
-DRAM_ATTR uint32 cycles_;
-int32 *p_external_control_cpu;
+DRAM_ATTR PCE_LOCAL uint32 cycles_;
+PCE_LOCAL int32 *p_external_control_cpu;
 
-//! External rom size hack for shared memory indication
-extern int ROM_size;
-
-/**
-  * Predeclaration of access functions
-	**/
-uchar read_memory_simple(uint16);
-uchar read_memory_sf2(uint16);
-uchar read_memory_arcade_card(uint16);
-
-void write_memory_simple(uint16, uchar);
-void write_memory_arcade_card(uint16, uchar);
-
-
-
-//! Function to write into memory. Defaulted to the basic one
-void (*write_memory_function) (uint16, uchar) = write_memory_simple;
-
-//! Function to read from memory. Defaulted to the basic one
-uchar(*read_memory_function) (uint16) = read_memory_simple;
+//! Banks 0x40-0x7F are switched by writes to ROM (Street Fighter II)
+PCE_LOCAL uchar sf2_mapper = 0;
 
 void
 hard_reset_io(void)
@@ -165,14 +147,89 @@ hard_reset_io(void)
     IO_VDC_reset
 }
 
+#if !defined(SHARED_MEMORY)
+
+#define CD_EXTRA_MEM_SIZE 0x10000
+#define CD_EXTRA_SUPER_MEM_SIZE 0x30000
+#define AC_EXTRA_MEM_SIZE 0x200000
+#define CD_SECTOR_BUFFER_SIZE 0x2000
+
+//! Internal RAM left for the tasks stacks and the drivers when pinning banks
+#define CD_INTERNAL_RAM_RESERVE 0x8000
+
+/**
+  * Allocate the CD, Super CD and Arcade Card RAM, only when a CD is emulated.
+  * HuCards get 4 bytes stubs so the pointers stay valid.
+  *
+  * Memory plan:
+  *  - banks 0x80-0x87 (CD RAM, 64KB) hold the code of CD games, they are put
+  *    in internal RAM with MY_USE_FAST_RAM if that still leaves
+  *    CD_INTERNAL_RAM_RESERVE free, else in SPIRAM
+  *  - banks 0x68-0x7F (Super CD RAM, 192KB) and the sector buffer go to SPIRAM
+  *  - the Arcade Card RAM (2MB) goes to SPIRAM. If it doesn't fit, the second
+  *    frame buffer is given back and the display becomes single buffered. If
+  *    it still doesn't fit, the Arcade Card emulation is disabled.
+  **/
+static void
+hard_init_cd_memory(void)
+{
+	unsigned long cd_extra_mem_size = 4;
+	unsigned long cd_extra_super_mem_size = 4;
+	unsigned long ac_extra_mem_size = 4;
+	unsigned long cd_sector_buffer_size = 4;
+	bool fast_cd_mem = false;
+
+	if (CD_emulation > 0) {
+		cd_extra_mem_size = CD_EXTRA_MEM_SIZE;
+		cd_extra_super_mem_size = CD_EXTRA_SUPER_MEM_SIZE;
+		cd_sector_buffer_size = CD_SECTOR_BUFFER_SIZE;
+#ifdef MY_USE_FAST_RAM
+		fast_cd_mem = my_special_free_largest(true)
+			>= CD_EXTRA_MEM_SIZE + CD_INTERNAL_RAM_RESERVE;
+#endif
+	}
+
+	hard_pce->cd_extra_mem = (uchar *) my_special_alloc(fast_cd_mem, 1, cd_extra_mem_size);
+	hard_pce->cd_extra_super_mem = (uchar *) my_special_alloc(false, 1, cd_extra_super_mem_size);
+	hard_pce->cd_sector_buffer = (uchar *) my_special_alloc(false, 1, cd_sector_buffer_size);
+
+	hard_pce->ac_extra_mem = NULL;
+	if ((CD_emulation > 0) && (option.want_arcade_card_emulation)) {
+		hard_pce->ac_extra_mem = (uchar *) my_special_alloc_try(false, 1, AC_EXTRA_MEM_SIZE);
+		if (!hard_pce->ac_extra_mem && my_special_release_framebuffer())
+			hard_pce->ac_extra_mem = (uchar *) my_special_alloc_try(false, 1, AC_EXTRA_MEM_SIZE);
+
+		if (hard_pce->ac_extra_mem) {
+			ac_extra_mem_size = AC_EXTRA_MEM_SIZE;
+		} else {
+			MESSAGE_ERROR("Not enough memory for the Arcade Card, disabled\n");
+			option.want_arcade_card_emulation = 0;
+		}
+	}
+	if (!hard_pce->ac_extra_mem)
+		hard_pce->ac_extra_mem = (uchar *) my_special_alloc(false, 1, ac_extra_mem_size);
+
+	memset(hard_pce->cd_extra_mem, 0, cd_extra_mem_size * sizeof(uchar));
+	memset(hard_pce->cd_extra_super_mem, 0, cd_extra_super_mem_size * sizeof(uchar));
+	memset(hard_pce->ac_extra_mem, 0, ac_extra_mem_size * sizeof(uchar));
+	memset(hard_pce->cd_sector_buffer, 0, cd_sector_buffer_size * sizeof(uchar));
+
+	MESSAGE_INFO("CD memory: RAM %luKB (%s), Super RAM %luKB, Arcade %luKB\n",
+				 cd_extra_mem_size / 1024, fast_cd_mem ? "internal" : "SPIRAM",
+				 cd_extra_super_mem_size / 1024, ac_extra_mem_size / 1024);
+	dump_heap_info_short();
+}
+
+#endif
+
 /**
   * Initialize the hardware
   **/
 void
 hard_init(void)
 {
-    PageR = (uchar **)my_special_alloc(true, 1,8*4);
-    PageW = (uchar **)my_special_alloc(true, 1,8*4);
+    PageR = (uchar **)my_special_alloc(true, 1, 8 * sizeof(uchar *));
+    PageW = (uchar **)my_special_alloc(true, 1, 8 * sizeof(uchar *));
     //ROMMapR = (uchar **)my_special_alloc(true, 4,256*4);
     //ROMMapW = (uchar **)my_special_alloc(true, 4,256*4);
 	trap_ram_read = malloc(0x2000);
@@ -234,25 +291,7 @@ hard_init(void)
     memset(hard_pce->vchange, 0, VRAMSIZE/32*sizeof(uchar));
     memset(hard_pce->vchanges, 0, VRAMSIZE/128*sizeof(uchar));
 
-/*    
-#define cd_extra_mem_size 0x10000
-#define cd_extra_super_mem_size 0x30000
-#define ac_extra_mem_size 0x200000
-#define cd_sector_buffer_size 0x2000
-*/
-#define cd_extra_mem_size 4
-#define cd_extra_super_mem_size 4
-#define ac_extra_mem_size 4
-#define cd_sector_buffer_size 4
-
-    hard_pce->cd_extra_mem = (uchar *)my_special_alloc(false, 1, cd_extra_mem_size);//[0x10000];
-    hard_pce->cd_extra_super_mem = (uchar *)my_special_alloc(false, 1, cd_extra_super_mem_size);//[0x30000];
-    hard_pce->ac_extra_mem = (uchar *)my_special_alloc(false, 1, ac_extra_mem_size);//[0x200000];
-    hard_pce->cd_sector_buffer = (uchar *)my_special_alloc(false, 1, cd_sector_buffer_size);//[0x2000];
-    memset(hard_pce->cd_extra_mem, 0, cd_extra_mem_size*sizeof(uchar));
-    memset(hard_pce->cd_extra_super_mem, 0, cd_extra_super_mem_size*sizeof(uchar));
-    memset(hard_pce->ac_extra_mem, 0, ac_extra_mem_size*sizeof(uchar));
-    memset(hard_pce->cd_sector_buffer, 0, cd_sector_buffer_size*sizeof(uchar));
+    hard_init_cd_memory();
 
     //hard_pce->SPRAM = (uint16 *)my_special_alloc(false, 2, 64 * 4* sizeof(uint16));//[64 * 4];
     hard_pce->SPRAM = (uint16 *)my_special_alloc(fast1, 1, 64 * 4* sizeof(uint16));//[64 * 4];
@@ -306,14 +345,6 @@ hard_init(void)
 	hard_pce->rom_shared_memory_size = 0x2000 * ROM_size;
 
 #endif
-
-	if ((option.want_arcade_card_emulation) && (CD_emulation > 0)) {
-		read_memory_function = read_memory_arcade_card;
-		write_memory_function = write_memory_arcade_card;
-	} else {
-		read_memory_function = read_memory_simple;
-		write_memory_function = write_memory_simple;
-	}
 }
 
 /**
@@ -513,7 +544,7 @@ IO_read_(uint16 A)
 }
 
 #if defined(TEST_ROM_RELOCATED)
-extern uchar *ROM;
+extern PCE_LOCAL uchar *ROM;
 #endif
 
 #ifndef MY_INLINE_bank_set
@@ -552,13 +583,8 @@ bank_set(uchar P, uchar V)
 #endif
 
 	mmr[P] = V;
-	if (ROMMapR[V] == IOAREA) {
-		PageR[P] = IOAREA;
-		PageW[P] = IOAREA;
-	} else {
-		PageR[P] = ROMMapR[V] - P * 0x2000;
-		PageW[P] = ROMMapW[V] - P * 0x2000;
-	}
+	PageR[P] = (ROMMapR[V] == IOAREA) ? IOAREA : ROMMapR[V] - P * 0x2000;
+	PageW[P] = (ROMMapW[V] == IOAREA) ? IOAREA : ROMMapW[V] - P * 0x2000;
 #ifdef MY_PCENGINE_LOGGING
 	printf("%s: %d,%d -> %X\n", __func__, P, V, PageR[P]);
 #endif
@@ -574,67 +600,66 @@ write_memory_simple(uint16 A, uchar V)
 		PageW[A >> 13][A] = V;
 }
 
-void
-write_memory_sf2(uint16 A, uchar V)
+uchar
+read_memory_simple(uint16 A)
 {
-	if (PageW[A >> 13] == IOAREA)
-		IO_write(A, V);
+	if (PageR[A >> 13] != IOAREA)
+		return PageR[A >> 13][A];
 	else
-		/* support for SF2CE silliness */
-	if ((A & 0x1ffc) == 0x1ff0) {
-		int i;
+		return IO_read(A);
+}
+
+/**
+  * Street Fighter II mapper, banks 0x40-0x7F show one of the four 512KB
+  * pages above the first one. Computed from ROM, bank 0 may be a copy
+  * pinned in fast RAM
+  **/
+static void
+sf2_bank_switch(uchar page)
+{
+	int i;
 
-		ROMMapR[0x40] = ROMMapR[0] + 0x80000;
-		ROMMapR[0x40] += (A & 3) * 0x80000;
+	for (i = 0x40; i < 0x80; i++)
+		ROMMapR[i] = ROM + (page + 1) * 0x80000 + (i - 0x40) * 0x2000;
 
-		for (i = 0x41; i <= 0x7f; i++) {
-			ROMMapR[i] = ROMMapR[i - 1] + 0x2000;
-			// This could be slightly sped up by setting a fixed RAMMapW
-			ROMMapW[i] = ROMMapW[i - 1] + 0x2000;
-		}
-	} else
-		PageW[A >> 13][A] = V;
+	for (i = 0; i < 8; i++)
+		if (mmr[i] >= 0x40 && mmr[i] < 0x80)
+			bank_set(i, mmr[i]);
 }
 
 void
-write_memory_arcade_card(uint16 A, uchar V)
+mapper_write(uint16 A, uchar V)
 {
-	if ((mmr[A >> 13] >= 0x40) && (mmr[A >> 13] <= 0x43)) {
+	uchar bank = mmr[A >> 13];
+
+	if (bank >= 0x40 && bank <= 0x43) {
 		/*
 		   #if ENABLE_TRACING_CD
-		   fprintf(stderr, "writing 0x%02x to AC pseudo bank (%d)\n", V, mmr[A >> 13] - 0x40);
+		   fprintf(stderr, "writing 0x%02x to AC pseudo bank (%d)\n", V, bank - 0x40);
 		   #endif
 		 */
-		IO_write((uint16) (0x1A00 + ((mmr[A >> 13] - 0x40) << 4)), V);
-	} else if (PageW[A >> 13] == IOAREA)
-		IO_write(A, V);
-	else
-		PageW[A >> 13][A] = V;
-}
+		IO_write((uint16) (0x1A00 + ((bank - 0x40) << 4)), V);
+	} else if (sf2_mapper && bank < 0x80 && (A & 0x1FFC) == 0x1FF0)
+		sf2_bank_switch(A & 3);
 
-uchar
-read_memory_simple(uint16 A)
-{
-	if (PageR[A >> 13] != IOAREA)
-		return PageR[A >> 13][A];
-	else
-		return IO_read(A);
+	/* anything else is a write to ROM, dropped */
 }
 
 uchar
-read_memory_arcade_card(uint16 A)
+mapper_read(uint16 A)
 {
-	if ((mmr[A >> 13] >= 0x40) && (mmr[A >> 13] <= 0x43)) {
+	uchar bank = mmr[A >> 13];
+
+	if (bank >= 0x40 && bank <= 0x43) {
 		/*
 		   #if ENABLE_TRACING_CD
-		   fprintf(stderr, "reading AC pseudo bank (%d)\n", mmr[A >> 13] - 0x40);
+		   fprintf(stderr, "reading AC pseudo bank (%d)\n", bank - 0x40);
 		   #endif
 		 */
-		return IO_read((uint16) (0x1A00 + ((mmr[A >> 13] - 0x40) << 4)));
-	} else if (PageR[A >> 13] != IOAREA)
-		return PageR[A >> 13][A];
-	else
-		return IO_read(A);
+		return IO_read((uint16) (0x1A00 + ((bank - 0x40) << 4)));
+	}
+
+	return ROMMapR[bank][A & 0x1FFF];
 }
 
 #ifndef MY_EXCLUDE
@@ -58,12 +58,19 @@ void IO_write_(uint16 A, uchar V);
 uchar IO_read_(uint16 A);
 void bank_set(uchar P, uchar V);
 
-extern void (*write_memory_function) (uint16, uchar);
-extern uchar(*read_memory_function) (uint16);
+void write_memory_simple(uint16 A, uchar V);
+uchar read_memory_simple(uint16 A);
 
-#define Wr6502(A,V) ((*write_memory_function)((A),(V)))
+#define Wr6502(A,V) write_memory_simple((A),(V))
 
-#define Rd6502(A) ((*read_memory_function)(A))
+#define Rd6502(A) read_memory_simple(A)
+
+//! Accesses to the trapped banks of a mapper, reached through IOAREA pages
+void mapper_write(uint16 A, uchar V);
+uchar mapper_read(uint16 A);
+
+//! Banks 0x40-0x7F are switched by writes to ROM (Street Fighter II)
+extern PCE_LOCAL uchar sf2_mapper;
 
 void dump_pce_cpu_environment();
 
@@ -77,124 +84,124 @@ void dump_pce_cpu_environment();
   * Exported variables
   **/
 
-extern struct_hard_pce *hard_pce;
+extern PCE_LOCAL struct_hard_pce *hard_pce;
 // The global structure for all hardware variables
 
 #define io (*p_io)
 
-extern IO *p_io;
+extern PCE_LOCAL IO *p_io;
 // the global I/O status
 
-extern uchar *RAM;
+extern PCE_LOCAL uchar *RAM;
 // mem where variables are stocked (well, RAM... )
 // in reality, only 0x2000 bytes are used in a coregraphx and 0x8000 only
 // in a supergraphx
 
-extern uchar *WRAM;
+extern PCE_LOCAL uchar *WRAM;
 // extra backup memory
 // This memory lies in Interface Unit or eventually in RGB adaptator
 
-extern uchar *VRAM;
+extern PCE_LOCAL uchar *VRAM;
 // Video mem
 // 0x10000 bytes on coregraphx, the double on supergraphx I think
 // contain information about the sprites position/status, information
 // about the pattern and palette to use for each tile, and patterns
 // for use in sprite/tile rendering
 
-extern uint16 *SPRAM;
+extern PCE_LOCAL uint16 *SPRAM;
 // SPRAM = sprite RAM
 // The pc engine got a function to transfert a piece VRAM toward the inner
 // gfx cpu sprite memory from where data will be grabbed to render sprites
 
-extern uchar *Pal;
+extern PCE_LOCAL uchar *Pal;
 // PCE->PC Palette convetion array
 // Each of the 512 available PCE colors (333 RGB -> 512 colors)
 // got a correspondancy in the 256 fixed colors palette
 
-extern uchar *VRAM2, *VRAMS;
+extern PCE_LOCAL uchar *VRAM2, *VRAMS;
 // These are array to keep in memory the result of the linearisation of
 // PCE sprites and tiles
 
-extern uchar *vchange, *vchanges;
+extern PCE_LOCAL uchar *vchange, *vchanges;
 // These array are boolean array to know if we must update the
 // corresponding linear sprite representation in VRAM2 and VRAMS or not
 // if (vchanges[5] != 0) 6th pattern in VRAM2 must be updated
 
 #define scanline (*p_scanline)
 
-extern uint32 *p_scanline;
+extern PCE_LOCAL uint32 *p_scanline;
 // The current rendered line on screen
 
-extern uchar *PCM;
+extern PCE_LOCAL uchar *PCM;
 // The ADPCM array (0x10000 bytes)
 
 //! A pointer to know where we're currently reading data in the cd buffer
-extern uchar *cd_sector_buffer;
+extern PCE_LOCAL uchar *cd_sector_buffer;
 
 //! The real buffer into which data are written from the cd and in which we
 //! takes data to gives it back throught the cd ports
-extern uchar *cd_read_buffer;
+extern PCE_LOCAL uchar *cd_read_buffer;
 
 //! extra ram provided by the system CD card
-extern uchar *cd_extra_mem;
+extern PCE_LOCAL uchar *cd_extra_mem;
 
 //! extra ram provided by the super system CD card
-extern uchar *cd_extra_super_mem;
+extern PCE_LOCAL uchar *cd_extra_super_mem;
 
 //! extra ram provided by the Arcade card
-extern uchar *ac_extra_mem;
+extern PCE_LOCAL uchar *ac_extra_mem;
 
 //! remaining useful data in cd_read_buffer
-extern uint32 pce_cd_read_datacnt;
+extern PCE_LOCAL uint32 pce_cd_read_datacnt;
 
 //! number of sectors we must still read on cd
-extern uchar cd_sectorcnt;
+extern PCE_LOCAL uchar cd_sectorcnt;
 
 //! number of the current command of the cd interface
-extern uchar pce_cd_curcmd;
+extern PCE_LOCAL uchar pce_cd_curcmd;
 
-extern uchar *zp_base;
+extern PCE_LOCAL uchar *zp_base;
 // pointer to the beginning of the Zero Page area
 
-extern uchar *sp_base;
+extern PCE_LOCAL uchar *sp_base;
 // pointer to the beginning of the Stack Area
 
-extern uchar *mmr;
+extern PCE_LOCAL uchar *mmr;
 // Value of each of the MMR registers
 
-extern uchar *IOAREA;
+extern PCE_LOCAL uchar *IOAREA;
 // physical address on emulator machine of the IO area (fake address as it has to be handled specially)
 
 //! 
 //extern uchar *PageR[8];
-extern uchar **PageR;
-extern uchar *ROMMapR[256];
+extern PCE_LOCAL uchar **PageR;
+extern PCE_LOCAL uchar *ROMMapR[256];
 //extern uchar **ROMMapR;
 
 //extern uchar *PageW[8];
-extern uchar **PageW;
-extern uchar *ROMMapW[256];
+extern PCE_LOCAL uchar **PageW;
+extern PCE_LOCAL uchar *ROMMapW[256];
 //extern uchar **ROMMapW;
 
 //! False "ram"s in which you can read/write (to homogeneize writes into RAM, BRAM, ... as well as in rom) but the result isn't coherent
-extern uchar *trap_ram_read;
-extern uchar *trap_ram_write;
+extern PCE_LOCAL uchar *trap_ram_read;
+extern PCE_LOCAL uchar *trap_ram_write;
 
 // physical address on emulator machine of each of the 256 banks
 
 #define cyclecount (*p_cyclecount)
 
-extern uint32 *p_cyclecount;
+extern PCE_LOCAL uint32 *p_cyclecount;
 // Number of elapsed cycles
 
 //#define cyclecountold (*p_cyclecountold)
 
-extern uint32 *p_cyclecountold;
+extern PCE_LOCAL uint32 *p_cyclecountold;
 // Previous number of elapsed cycles
 
 #define external_control_cpu (*p_external_control_cpu)
 
-extern int32 *p_external_control_cpu;
+extern PCE_LOCAL int32 *p_external_control_cpu;
 
 #define TimerPeriod 1097
 // extern const uint32 TimerPeriod;
@@ -211,12 +218,12 @@ extern int32 *p_external_control_cpu;
 #define reg_p   (*p_reg_p)
 #define reg_s   (*p_reg_s)
 
-extern uint16 *p_reg_pc;
-extern uchar *p_reg_a;
-extern uchar *p_reg_x;
-extern uchar *p_reg_y;
-extern uchar *p_reg_p;
-extern uchar *p_reg_s;
+extern PCE_LOCAL uint16 *p_reg_pc;
+extern PCE_LOCAL uchar *p_reg_a;
+extern PCE_LOCAL uchar *p_reg_x;
+extern PCE_LOCAL uchar *p_reg_y;
+extern PCE_LOCAL uchar *p_reg_p;
+extern PCE_LOCAL uchar *p_reg_s;
 
 #else
 #define reg_pc reg_pc_
@@ -226,19 +233,19 @@ extern uchar *p_reg_s;
 #define reg_p reg_p_
 #define reg_s reg_s_
 
-extern uint32 reg_pc_;
-extern uchar reg_a_;
-extern uchar reg_x_;
-extern uchar reg_y_;
-extern uchar reg_p_;
-extern uchar reg_s_;
+extern PCE_LOCAL uint32 reg_pc_;
+extern PCE_LOCAL uchar reg_a_;
+extern PCE_LOCAL uchar reg_x_;
+extern PCE_LOCAL uchar reg_y_;
+extern PCE_LOCAL uchar reg_p_;
+extern PCE_LOCAL uchar reg_s_;
 #endif
 
 // These are the main h6280 register, reg_p is the flag register
 
 //#define cycles (*p_cycles)
 //extern uint32 *p_cycles;
-extern uint32 cycles_;
+extern PCE_LOCAL uint32 cycles_;
 
 // Number of pc engine cycles elapsed since the resetting of the emulated console
 
@@ -286,13 +293,9 @@ enum _VDC_REG {
 #define bank_set(P, V) \
     { \
     mmr[P] = V; \
-    if (ROMMapR[V] == IOAREA) { \
-        PageR[P] = IOAREA; \
-        PageW[P] = IOAREA; \
-    } else { \
-        PageR[P] = ROMMapR[V] - P * 0x2000; \
-        PageW[P] = ROMMapW[V] - P * 0x2000; \
-    } }
+    PageR[P] = (ROMMapR[V] == IOAREA) ? IOAREA : ROMMapR[V] - P * 0x2000; \
+    PageW[P] = (ROMMapW[V] == IOAREA) ? IOAREA : ROMMapW[V] - P * 0x2000; \
+    }
     //if (P == 7) printf("%s: bank_set: %d,%d -> %X (%X)\n", __func__, P, V, PageR[P], ROMMapR[V]);
 
 #endif
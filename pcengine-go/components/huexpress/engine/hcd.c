@@ -673,4 +673,9 @@ void
 HCD_handle_subtitle()
 {
 }
+
+void
+HCD_shutdown()
+{
+}
 #endif
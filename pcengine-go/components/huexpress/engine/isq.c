@@ -0,0 +1,210 @@
+/***************************************************************************/
+/*                                                                         */
+/*                         Packed ISO Source File                          */
+/*                                                                         */
+/*     Reading of CISO packed images. Hunks are inflated with the miniz    */
+/*     decoder from the ESP32 ROM (zlib on the host) and kept in a small   */
+/*     LRU, so sequential reads inside a hunk only cost a memcpy.          */
+/*                                                                         */
+/***************************************************************************/
+
+#include "isq.h"
+#include "pce.h"
+
+#include <string.h>
+
+#include "tinfl.h"
+
+#define ISQ_HEADER_SIZE 24
+
+//! Index entries with this bit set point to a hunk stored uncompressed
+#define ISQ_PLAIN 0x80000000
+
+typedef struct {
+	uint32 hunk;
+	uint32 last_use;
+	uchar *data;
+} isq_cache_entry;
+
+static FILE *isq_file = NULL;
+static uint32 isq_total_bytes;
+static uint32 isq_hunk_size;
+static uint32 isq_hunks;
+static uchar isq_align;
+
+//! Offset of each hunk in the file, one more entry for the end of the last
+static uint32 *isq_index = NULL;
+
+static isq_cache_entry isq_cache[ISQ_CACHE_HUNKS];
+static uchar *isq_packed = NULL;
+//! Hunk size the cache entries were allocated for
+static uint32 isq_buffer_size = 0;
+static uint32 isq_clock;
+
+/* Statistics */
+static uint32 isq_hits, isq_misses, isq_bytes_read;
+
+
+static uint32
+get_le32(uchar * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+
+int
+isq_open(FILE * file)
+{
+	uchar header[ISQ_HEADER_SIZE];
+	uint32 i;
+
+	isq_close();
+
+	if (fseek(file, 0, SEEK_SET)
+		|| fread(header, ISQ_HEADER_SIZE, 1, file) != 1
+		|| memcmp(header, "CISO", 4)) {
+		MESSAGE_ERROR("ISQ: not a CISO image\n");
+		return 0;
+	}
+
+	// 64 bits size, images above 4GB don't exist for this console
+	isq_total_bytes = get_le32(header + 8);
+	isq_hunk_size = get_le32(header + 16);
+	isq_align = header[21];
+
+	if (isq_hunk_size < 2048 || isq_hunk_size > ISQ_HUNK_SIZE_MAX
+		|| isq_hunk_size % 2048) {
+		MESSAGE_ERROR("ISQ: unsupported hunk size %d\n", isq_hunk_size);
+		return 0;
+	}
+
+	isq_hunks = (isq_total_bytes + isq_hunk_size - 1) / isq_hunk_size;
+
+	isq_index = (uint32 *) my_special_alloc(false, 4, (isq_hunks + 1) * 4);
+	if (fread(isq_index, 4, isq_hunks + 1, file) != isq_hunks + 1) {
+		MESSAGE_ERROR("ISQ: truncated hunk table\n");
+		isq_close();
+		return 0;
+	}
+	for (i = 0; i <= isq_hunks; i++)
+		isq_index[i] = get_le32((uchar *) & isq_index[i]);
+
+	// Sized for this image, kept for the next ones up to the same size
+	if (isq_hunk_size > isq_buffer_size) {
+		for (i = 0; i < ISQ_CACHE_HUNKS; i++) {
+			free(isq_cache[i].data);
+			isq_cache[i].data =
+				(uchar *) my_special_alloc(false, 1, isq_hunk_size);
+		}
+		// A deflated hunk can be a bit bigger than the hunk itself
+		free(isq_packed);
+		isq_packed =
+			(uchar *) my_special_alloc(false, 1, isq_hunk_size + 0x800);
+		isq_buffer_size = isq_hunk_size;
+	}
+
+	for (i = 0; i < ISQ_CACHE_HUNKS; i++) {
+		isq_cache[i].hunk = 0xFFFFFFFF;
+		isq_cache[i].last_use = 0;
+	}
+
+	isq_file = file;
+	isq_clock = 0;
+	isq_hits = isq_misses = isq_bytes_read = 0;
+
+	MESSAGE_INFO("ISQ: %d sectors in %d hunks of %d bytes\n",
+				 isq_total_bytes / 2048, isq_hunks, isq_hunk_size);
+	return 1;
+}
+
+
+void
+isq_close(void)
+{
+	if (isq_file)
+		MESSAGE_INFO("ISQ: hits=%d misses=%d read=%dKB\n",
+					 isq_hits, isq_misses, isq_bytes_read / 1024);
+
+	if (isq_index)
+		free(isq_index);
+	isq_index = NULL;
+	isq_file = NULL;
+}
+
+
+uint32
+isq_size(void)
+{
+	return isq_file ? isq_total_bytes : 0;
+}
+
+
+//! Inflate a hunk into a cache entry, returns 0 on failure
+static int
+isq_load(uint32 hunk, uchar * data)
+{
+	uint32 begin = (isq_index[hunk] & ~ISQ_PLAIN) << isq_align;
+	uint32 end = (isq_index[hunk + 1] & ~ISQ_PLAIN) << isq_align;
+	uint32 length = end - begin;
+
+	if (end < begin || length > isq_buffer_size + 0x800)
+		return 0;
+
+	if (fseek(isq_file, begin, SEEK_SET))
+		return 0;
+
+	isq_bytes_read += length;
+
+	if (isq_index[hunk] & ISQ_PLAIN)
+		return fread(data, 1, MIN(length, isq_hunk_size), isq_file) > 0;
+
+	if (fread(isq_packed, 1, length, isq_file) != length)
+		return 0;
+
+	// Raw deflate streams, without zlib header
+	return tinfl_decompress_mem_to_mem(data, isq_hunk_size, isq_packed,
+									   length, 0)
+		!= TINFL_DECOMPRESS_MEM_TO_MEM_FAILED;
+}
+
+
+void
+isq_read_sector(uchar * p, uint32 index)
+{
+	uint32 hunk = index * 2048 / isq_hunk_size;
+	isq_cache_entry *entry = &isq_cache[0];
+	int i;
+
+	if (!isq_file || hunk >= isq_hunks) {
+		memset(p, 0, 2048);
+		return;
+	}
+
+	isq_clock++;
+
+	for (i = 0; i < ISQ_CACHE_HUNKS; i++) {
+		if (isq_cache[i].hunk == hunk) {
+			entry = &isq_cache[i];
+			break;
+		}
+		// Keep the least recently used entry for a miss
+		if (isq_cache[i].last_use < entry->last_use)
+			entry = &isq_cache[i];
+	}
+
+	if (entry->hunk == hunk)
+		isq_hits++;
+	else {
+		isq_misses++;
+		entry->hunk = hunk;
+		if (!isq_load(hunk, entry->data)) {
+			MESSAGE_ERROR("ISQ: couldn't unpack hunk %d\n", hunk);
+			entry->hunk = 0xFFFFFFFF;
+			memset(p, 0, 2048);
+			return;
+		}
+	}
+	entry->last_use = isq_clock;
+
+	memcpy(p, entry->data + (index * 2048) % isq_hunk_size, 2048);
+}
@@ -0,0 +1,33 @@
+#ifndef _ISQ_H_
+#define _ISQ_H_
+
+#include <stdio.h>
+
+#include "cleantypes.h"
+
+/*
+ * Packed ISO images (ISQ), stored in the CISO format: the image is cut in
+ * hunks of a fixed size, each one deflated on its own, and found through a
+ * table of offsets. Files made by ciso or maxcso (--block=16384 packs 8
+ * sectors per hunk) can be used as is.
+ */
+
+//! Decompressed hunks kept in memory
+#define ISQ_CACHE_HUNKS 8
+
+//! Biggest hunk accepted, the cache holds ISQ_CACHE_HUNKS hunks of the
+//! image's size
+#define ISQ_HUNK_SIZE_MAX 0x10000
+
+//! Read the header and the hunk table, returns 0 on failure
+int isq_open(FILE * file);
+
+void isq_close(void);
+
+//! Size of the unpacked image, in bytes
+uint32 isq_size(void);
+
+//! Copy the 2048 bytes of sector index of the unpacked image into p
+void isq_read_sector(uchar * p, uint32 index);
+
+#endif
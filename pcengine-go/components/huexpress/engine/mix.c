@@ -74,13 +74,15 @@ sdl_fill_audio(void *data, Uint8 * stream, int len)
 
 }
 
+#endif
+
 
 /*
  *
- * Lookup tables for IMA ADPCM format
+ * Lookup tables for OKI (MSM5205) ADPCM format
  *
  */
-int AdpcmIndexAdjustTable[16] = {
+static const int AdpcmIndexAdjustTable[16] = {
     -1, -1, -1, -1,             /* +0 - +3, decrease the step size */
     2, 4, 6, 8,                 /* +4 - +7, increase the step size */
     -1, -1, -1, -1,             /* -0 - -3, decrease the step size */
@@ -89,7 +91,7 @@ int AdpcmIndexAdjustTable[16] = {
 
 #define ADPCM_MAX_INDEX 48
 
-int AdpcmStepSizeTable[ADPCM_MAX_INDEX + 1] = {
+static const int AdpcmStepSizeTable[ADPCM_MAX_INDEX + 1] = {
     16, 17, 19, 21, 23, 25, 28,
     31, 34, 37, 41, 45, 50, 55,
     60, 66, 73, 80, 88, 97, 107,
@@ -100,7 +102,6 @@ int AdpcmStepSizeTable[ADPCM_MAX_INDEX + 1] = {
     1166, 1282, 1411, 1552
 };
 
-#endif
 
 int
 mseq(uint32 * rand_val)
@@ -116,52 +117,60 @@ mseq(uint32 * rand_val)
 
 
 
-/* TODO : improve pointer in adpcm buffer maybe using fixed type */
+/*
+ * Decode a whole block of adpcm in one go. Nibbles are read from the PCM
+ * ram starting at nibble 'begin' (at most 'nibbles' of them) and resampled
+ * from 32000 / io.adpcm_rate Hz to host.sound.freq using 16.16 fixed
+ * arithmetic, carried over in *Phase from one block to the next, like
+ * WriteBuffer does for the psg. Output is 8 bit signed, interleaved when
+ * stereo, so that it can be mixed as a seventh channel.
+ * Returns the number of nibbles consumed.
+ */
 uint32
-WriteBufferAdpcm8(uchar * buf, uint32 begin, uint32 size, char *Index,
-                  int32 * PreviousValue)
+WriteBufferAdpcm8(char *buf, uint32 begin, uint32 nibbles, unsigned dwSize,
+                  char *Index, int32 * PreviousValue, uint32 * Phase)
 {
+    uint32 fixed_n = *Phase;
+    uint32 fixed_inc;
     uint32 ret_val = 0;
-
-    /* TODO: use something else than ALLEGRO's fixed to make this portable */
-#ifdef ALLEGRO
-    int32 step, difference, deltaCode;
-    char index = *Index;
+    unsigned dwPos = 0;
+    int32 index = *Index;
     int32 previousValue = *PreviousValue;
-    fixed FixedIndex = 0, FixedInc;
-
+    int32 step, difference, deltaCode;
+    signed char sample;
 
-    if (io.adpcm_rate)
-        FixedInc =
-            ftofix((float) io.adpcm_rate * 1000 / (float) host.sound.freq);
-    else
+    if (!io.adpcm_rate || !nibbles) {
+        *Phase = 0;
+        memset(buf, 0, dwSize * host.sound.sample_size);
         return 0;
+    }
 
-    while (size) {
+    /* 32000 << 16 still fits in 32 bits */
+    fixed_inc = ((uint32) 32000 << 16) / ((uint32) io.adpcm_rate * host.sound.freq);
 
-        FixedIndex += FixedInc;
+    sample = (signed char) (previousValue >> 4);
 
-        while (FixedIndex > itofix(1)) {
+    while (dwPos < dwSize) {
+        fixed_n += fixed_inc;
 
-            FixedIndex -= itofix(1);
+        while (fixed_n >= 0x10000) {
+            if (ret_val == nibbles)
+                break;
 
-            ret_val++;
+            fixed_n -= 0x10000;
 
-            deltaCode = PCM[begin >> 1];
+            deltaCode = PCM[(begin >> 1) & 0xFFFF];
 
             if (begin & 1)
                 deltaCode >>= 4;
             else
                 deltaCode &= 0xF;
 
-            step = AdpcmStepSizeTable[index];
-
             begin++;
+            ret_val++;
 
-            begin &= 0x1FFFF;
-            // Make the adpcm repeat from beginning once finished
+            step = AdpcmStepSizeTable[index];
 
-            /* Construct the difference by scaling the current step size */
             /* This is approximately: difference = (deltaCode+.5)*step/4 */
             difference = step >> 3;
             if (deltaCode & 1)
@@ -172,15 +181,15 @@ WriteBufferAdpcm8(uchar * buf, uint32 begin, uint32 size, char *Index,
                 difference += step;
 
             if (deltaCode & 8)
-                difference = -difference;
-
-            /* Build the new sample */
-            previousValue += difference;
+                previousValue -= difference;
+            else
+                previousValue += difference;
 
-            if (previousValue > 32767)
-                previousValue = 32767;
-            else if (previousValue < -32768)
-                previousValue = -32768;
+            /* The MSM5205 works with 12 bit samples */
+            if (previousValue > 2047)
+                previousValue = 2047;
+            else if (previousValue < -2048)
+                previousValue = -2048;
 
             index += AdpcmIndexAdjustTable[deltaCode];
             if (index < 0)
@@ -188,20 +197,32 @@ WriteBufferAdpcm8(uchar * buf, uint32 begin, uint32 size, char *Index,
             else if (index > ADPCM_MAX_INDEX)
                 index = ADPCM_MAX_INDEX;
 
+            sample = (signed char) (previousValue >> 4);
+        }
+
+        if (fixed_n >= 0x10000) {
+            /*
+             * We ran out of nibbles, the sample is over: fill the remaining
+             * of the block with silence.
+             */
+            fixed_n = 0;
+            memset(buf, 0, (dwSize - dwPos) * host.sound.sample_size);
+            break;
         }
-        /* TEST, was 5 */
-        *(buf++) = (previousValue << 6) >> 8;
 
-        size--;
+        *buf++ = sample;
 
+        if (host.sound.stereo) {
+            *buf++ = sample;
+            dwPos += 2;
+        } else {
+            dwPos++;
+        }
     }
 
     *Index = index;
     *PreviousValue = previousValue;
-
-#else
-    memset(buf, 0, host.sound.sample_size);
-#endif
+    *Phase = fixed_n;
 
     return ret_val;
 }
@@ -210,12 +231,12 @@ WriteBufferAdpcm8(uchar * buf, uint32 begin, uint32 size, char *Index,
 void
 WriteBuffer(char *buf, int ch, unsigned dwSize)
 {
-    static uint32 fixed_n[6] = { 0, 0, 0, 0, 0, 0 };
+    static PCE_LOCAL uint32 fixed_n[6] = { 0, 0, 0, 0, 0, 0 };
     uint32 fixed_inc;
-    static uint32 k[6] = { 0, 0, 0, 0, 0, 0 };
-    static uint32 t;            // used to know how much we got to advance in the ring buffer
-    static uint32 r[6];
-    static uint32 rand_val[6] = { 0, 0, 0, 0, 0x51F631E4, 0x51F631E4 }; // random seed for 'noise' generation
+    static PCE_LOCAL uint32 k[6] = { 0, 0, 0, 0, 0, 0 };
+    static PCE_LOCAL uint32 t;            // used to know how much we got to advance in the ring buffer
+    static PCE_LOCAL uint32 r[6];
+    static PCE_LOCAL uint32 rand_val[6] = { 0, 0, 0, 0, 0x51F631E4, 0x51F631E4 }; // random seed for 'noise' generation
     uint16 dwPos = 0;
     int32 vol;
     uint32 Tp;
@@ -255,7 +276,7 @@ WriteBuffer(char *buf, int ch, unsigned dwSize)
         /*
          * There is 'direct access' audio to be played.
          */
-        static uint32 da_index[6] = { 0, 0, 0, 0, 0, 0 };
+        static PCE_LOCAL uint32 da_index[6] = { 0, 0, 0, 0, 0, 0 };
         uint16 index = da_index[ch] >> 16;
 
         /*
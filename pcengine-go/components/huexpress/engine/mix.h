@@ -7,9 +7,11 @@
 #include "debug.h"
 
 
-uint32 WriteBufferAdpcm8(uchar * buf,
+uint32 WriteBufferAdpcm8(char *buf,
 						 uint32 begin,
-						 uint32 size, char *Index, int32 * PreviousValue);
+						 uint32 nibbles, unsigned dwSize,
+						 char *Index, int32 * PreviousValue,
+						 uint32 * Phase);
 
 void WriteBuffer(char *buf, int ch, unsigned dwSize);
 
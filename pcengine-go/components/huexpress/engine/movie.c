@@ -0,0 +1,228 @@
+/***************************************************************************/
+/*                                                                         */
+/*                         Input movie Source File                         */
+/*                                                                         */
+/*     Records the joypads frame by frame and plays them back, the file    */
+/*     only holds the changes. See movie.h for the format.                 */
+/*                                                                         */
+/***************************************************************************/
+
+#include <string.h>
+#include <sys/time.h>
+
+#include "pce.h"
+
+//! No more change to play
+#define MOVIE_END 0xFFFFFFFF
+
+#define MOVIE_HEADER_SIZE 16
+#define MOVIE_FRAMES_OFFSET 12
+
+PCE_LOCAL pce_movie movie;
+
+
+static double
+movie_time(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+
+static void
+movie_write32(uchar * data, uint32 value)
+{
+	data[0] = value;
+	data[1] = value >> 8;
+	data[2] = value >> 16;
+	data[3] = value >> 24;
+}
+
+
+static uint32
+movie_read32(uchar * data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32) data[3] << 24);
+}
+
+
+static void
+movie_write_count(uint32 count)
+{
+	while (count >= 0x80) {
+		fputc((count & 0x7F) | 0x80, movie.file);
+		count >>= 7;
+	}
+	fputc(count, movie.file);
+}
+
+
+//! Set change_frame to the frame of the next record
+static void
+movie_read_count(void)
+{
+	uint32 count = 0;
+	int shift = 0;
+	int byte;
+
+	do {
+		if ((byte = fgetc(movie.file)) == EOF || shift > 28) {
+			movie.change_frame = MOVIE_END;
+			return;
+		}
+		count |= (byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+
+	movie.change_frame += count;
+}
+
+
+int
+movie_record(const char *path)
+{
+	uchar header[MOVIE_HEADER_SIZE] = { 'H', 'U', 'M', 'V',
+		MOVIE_VERSION, MOVIE_PADS
+	};
+
+	movie_stop();
+
+	if (!(movie.file = fopen(path, "wb"))) {
+		MESSAGE_ERROR("Couldn't create %s\n", path);
+		return 1;
+	}
+
+	// The length is filled when stopping
+	movie_write32(header + 8, ROM_CRC);
+	fwrite(header, MOVIE_HEADER_SIZE, 1, movie.file);
+
+	movie.mode = MOVIE_RECORD;
+	movie.frame = 0;
+	movie.change_frame = 0;
+	memset(movie.pads, 0, MOVIE_PADS);
+
+	MESSAGE_INFO("Recording the input to %s\n", path);
+	return 0;
+}
+
+
+int
+movie_play(const char *path, uchar max_speed)
+{
+	uchar header[MOVIE_HEADER_SIZE];
+
+	movie_stop();
+
+	if (!(movie.file = fopen(path, "rb"))) {
+		MESSAGE_ERROR("Couldn't open %s\n", path);
+		return 1;
+	}
+
+	if (fread(header, MOVIE_HEADER_SIZE, 1, movie.file) != 1
+		|| memcmp(header, "HUMV", 4) || header[4] != MOVIE_VERSION
+		|| header[5] != MOVIE_PADS) {
+		MESSAGE_ERROR("%s isn't a movie\n", path);
+		fclose(movie.file);
+		return 1;
+	}
+
+	if (movie_read32(header + 8) != ROM_CRC) {
+		MESSAGE_ERROR("%s was recorded with another rom (CRC=%08X)\n", path,
+			movie_read32(header + 8));
+		fclose(movie.file);
+		return 1;
+	}
+
+	movie.mode = MOVIE_PLAY;
+	movie.frame = 0;
+	movie.frames = movie_read32(header + MOVIE_FRAMES_OFFSET);
+	movie.change_frame = 0;
+	movie_read_count();
+	memset(movie.pads, 0, MOVIE_PADS);
+	movie.max_speed = max_speed;
+	movie.start_time = movie_time();
+
+	MESSAGE_INFO("Playing %s, %u frames\n", path, movie.frames);
+	return 0;
+}
+
+
+void
+movie_stop(void)
+{
+	uchar frames[4];
+	double seconds;
+
+	switch (movie.mode) {
+	case MOVIE_RECORD:
+		movie_write32(frames, movie.frame);
+		fseek(movie.file, MOVIE_FRAMES_OFFSET, SEEK_SET);
+		fwrite(frames, 4, 1, movie.file);
+		MESSAGE_INFO("Movie: %u frames recorded\n", movie.frame);
+		break;
+	case MOVIE_PLAY:
+		seconds = movie_time() - movie.start_time;
+		MESSAGE_INFO("Movie: %u frames played in %.2fs, %.1f fps\n",
+			movie.frame, seconds, seconds > 0 ? movie.frame / seconds : 0);
+		break;
+	default:
+		return;
+	}
+
+	fclose(movie.file);
+	movie.file = NULL;
+	movie.mode = MOVIE_OFF;
+}
+
+
+void
+movie_frame(void)
+{
+	uchar mask = 0;
+	int pad, byte;
+
+	switch (movie.mode) {
+	case MOVIE_RECORD:
+		for (pad = 0; pad < MOVIE_PADS; pad++)
+			if (io.JOY[pad] != movie.pads[pad])
+				mask |= 1 << pad;
+
+		if (mask) {
+			movie_write_count(movie.frame - movie.change_frame);
+			fputc(mask, movie.file);
+			for (pad = 0; pad < MOVIE_PADS; pad++)
+				if (mask & (1 << pad)) {
+					fputc(io.JOY[pad] ^ movie.pads[pad], movie.file);
+					movie.pads[pad] = io.JOY[pad];
+				}
+			movie.change_frame = movie.frame;
+		}
+
+		movie.frame++;
+		break;
+
+	case MOVIE_PLAY:
+		if (movie.frame == movie.change_frame) {
+			// A recording cut by a power off may end in the middle of one
+			if ((byte = fgetc(movie.file)) != EOF)
+				mask = byte;
+			for (pad = 0; pad < MOVIE_PADS; pad++)
+				if ((mask & (1 << pad)) && (byte = fgetc(movie.file)) != EOF)
+					movie.pads[pad] ^= byte;
+			movie_read_count();
+		}
+
+		memcpy(io.JOY, movie.pads, MOVIE_PADS);
+		movie.frame++;
+
+		if (movie.frames ? movie.frame >= movie.frames
+			: movie.change_frame == MOVIE_END)
+			movie_stop();
+		break;
+
+	default:
+		break;
+	}
+}
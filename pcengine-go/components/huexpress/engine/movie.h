@@ -0,0 +1,67 @@
+#ifndef _MOVIE_H_
+#define _MOVIE_H_
+
+#include <stdio.h>
+
+#include "cleantypes.h"
+
+/*
+ * Input movies: the state of the five joypads for every frame since the
+ * console was reset, so a run can be replayed exactly, on any machine.
+ *
+ * The file starts with a 16 bytes header:
+ *   "HUMV", version, number of pads, 2 reserved bytes,
+ *   CRC of the rom, number of frames (both little endian, 0 if unknown).
+ * Then comes one record per change of the pads:
+ *   frames since the previous change (LEB128), mask of the pads that
+ *   changed, then the XOR of the old and new state of each of them.
+ *
+ * movie_frame() is called once per frame, right after osd_keyboard() set
+ * io.JOY: it records io.JOY, or overwrites it with the movie.
+ */
+
+#define MOVIE_PADS 5
+
+#define MOVIE_VERSION 1
+
+typedef enum {
+	MOVIE_OFF,
+	MOVIE_RECORD,
+	MOVIE_PLAY
+} movie_mode;
+
+typedef struct {
+	movie_mode mode;
+	FILE *file;
+	//! Frames recorded or played so far
+	uint32 frame;
+	//! Length of the movie being played, 0 to play until the last change
+	uint32 frames;
+	//! Frame of the next change to play, or of the last one recorded
+	uint32 change_frame;
+	uchar pads[MOVIE_PADS];
+	//! Playing without display nor vsync, for benchmarks
+	uchar max_speed;
+	double start_time;
+} pce_movie;
+
+extern PCE_LOCAL pce_movie movie;
+
+//! Record the input of the console from its next frame, call it after InitPCE
+//! \return 0 on success
+int movie_record(const char *path);
+
+//! Play a movie recorded for the rom loaded by InitPCE, before its first frame
+//! \return 0 on success
+int movie_play(const char *path, uchar max_speed);
+
+//! Finish the recording or stop the playback
+void movie_stop(void);
+
+//! Record or replay io.JOY for the current frame
+void movie_frame(void);
+
+//! Skip the display and the vsync wait
+#define movie_max_speed() (movie.mode == MOVIE_PLAY && movie.max_speed)
+
+#endif
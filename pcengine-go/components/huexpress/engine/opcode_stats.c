@@ -0,0 +1,67 @@
+/***************************************************************************/
+/*                                                                         */
+/*                       Opcode statistics Source File                     */
+/*                                                                         */
+/*     Counters filled by the switch core when MY_OPCODE_STATS is set,     */
+/*     and their CSV export.                                               */
+/*                                                                         */
+/***************************************************************************/
+
+#include "pce.h"
+
+#ifdef MY_OPCODE_STATS
+
+#include <string.h>
+
+#include "defs.h"
+
+extern operation optable_runtime[256];
+
+PCE_LOCAL uint32 opcode_stats_count[256];
+PCE_LOCAL uint64 opcode_stats_time[256];
+PCE_LOCAL uchar opcode_stats_lookup[256];
+
+static PCE_LOCAL int opcode_stats_ticks = 0;
+
+
+void
+opcode_stats_log(void)
+{
+	uint64 total = 0;
+	int opcode;
+
+	for (opcode = 0; opcode < 256; opcode++)
+		total += opcode_stats_time[opcode];
+
+	if (!total)
+		return;
+
+	printf("opcode,name,lookup,count,host_cycles,cycles_per_op,time_percent\n");
+	for (opcode = 0; opcode < 256; opcode++) {
+		if (!opcode_stats_count[opcode])
+			continue;
+
+		printf("0x%02X,%s,%d,%u,%llu,%.1f,%.2f\n", opcode,
+			optable_runtime[opcode].opname, opcode_stats_lookup[opcode],
+			opcode_stats_count[opcode],
+			(unsigned long long) opcode_stats_time[opcode],
+			(double) opcode_stats_time[opcode] / opcode_stats_count[opcode],
+			100.0 * opcode_stats_time[opcode] / total);
+	}
+
+	memset(opcode_stats_count, 0, sizeof(opcode_stats_count));
+	memset(opcode_stats_time, 0, sizeof(opcode_stats_time));
+}
+
+
+void
+opcode_stats_tick(void)
+{
+	if (++opcode_stats_ticks < OPCODE_STATS_PERIOD)
+		return;
+
+	opcode_stats_ticks = 0;
+	opcode_stats_log();
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef _OPCODE_STATS_H_
+#define _OPCODE_STATS_H_
+
+#include "cleantypes.h"
+
+/*
+ * Per opcode statistics of the switch core: how many times each opcode ran,
+ * the host cycles it took, and whether it still goes through optable_runtime
+ * instead of being inlined. Logged as CSV, one line per opcode used.
+ */
+
+#ifdef MY_OPCODE_STATS
+
+#if defined(ESP_PLATFORM)
+#include "esp_system.h"
+#define opcode_stats_clock() ((uint32) xthal_get_ccount())
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define opcode_stats_clock() ((uint32) __rdtsc())
+#else
+#include <time.h>
+static inline uint32
+opcode_stats_clock(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000u + now.tv_nsec;
+}
+#endif
+
+//! Calls of opcode_stats_tick between two logs
+#define OPCODE_STATS_PERIOD 10
+
+extern PCE_LOCAL uint32 opcode_stats_count[256];
+extern PCE_LOCAL uint64 opcode_stats_time[256];
+extern PCE_LOCAL uchar opcode_stats_lookup[256];
+
+//! Log the statistics as CSV and start again
+void opcode_stats_log(void);
+
+//! Log every OPCODE_STATS_PERIOD calls, the fps display calls it every second
+void opcode_stats_tick(void);
+
+#define opcode_stats_start() \
+    uint32 opcode_stats_start_time = opcode_stats_clock();
+
+#define opcode_stats_end(opcode_) { \
+    opcode_stats_count[opcode_]++; \
+    opcode_stats_time[opcode_] += opcode_stats_clock() - opcode_stats_start_time; \
+    }
+
+//! The opcode isn't inlined in the switch
+#define opcode_stats_mark_lookup(opcode_) opcode_stats_lookup[opcode_] = 1;
+
+#else
+
+#define opcode_stats_start()
+#define opcode_stats_end(opcode_)
+#define opcode_stats_mark_lookup(opcode_)
+#define opcode_stats_log()
+#define opcode_stats_tick()
+
+#endif
+
+#endif
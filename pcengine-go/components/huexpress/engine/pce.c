@@ -33,9 +33,16 @@
 #if defined(BSD_CD_HARDWARE_SUPPORT)
 #include "pcecd.h"
 #endif
+#include "cd_cache.h"
+#include "cue.h"
+#include "isq.h"
 
 #include "romdb.h"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #define LOG_NAME "huexpress.log"
 
 #define CD_FRAMES 75
@@ -65,7 +72,22 @@ const uint32 PopRAMsize = 0x8000;
 //byte ZBuf[ZW*256];
 //BOOL IsROM[8];
 
-uchar *ROM = NULL;
+PCE_LOCAL uchar *ROM = NULL;
+
+#if defined(__linux__)
+//! Rom file mapped privately, ROM points past its header. Pages are only
+//! copied when written, i.e. for US encoded cards
+static PCE_LOCAL uchar *ROM_map = NULL;
+static PCE_LOCAL size_t ROM_map_size;
+
+//! Data track file of ISO and BIN images, mapped read only
+static uchar *iso_map = NULL;
+static size_t iso_map_size;
+#endif
+
+//! CRC computed from the bytes loaded by CartLoad, spares a second read
+static PCE_LOCAL uint32 ROM_crc;
+static PCE_LOCAL uchar ROM_crc_valid = 0;
 // IOAREA = a pointer to the emulated IO zone
 // vchange = array of boolean to know whether bg tiles have changed (i.e.
 //      vchanges[5]==1 means the 6th tile have changed and VRAM2 should be updated)
@@ -77,7 +99,7 @@ uchar CDBIOS_replace[0x4d][2];
 // Used to know what byte do we have replaced to hook bios functions so that
 // we can restore them if needed
 
-int ROM_size;
+PCE_LOCAL int ROM_size;
 // obvious, no ?
 // actually, the number of block of 0x2000 bytes in the rom
 
@@ -175,16 +197,19 @@ uchar populus = 0;
 uchar US_encoded_card = 0;
 // Do we have to swap bit order in the rom
 
-uint16 NO_ROM;
+PCE_LOCAL uint16 NO_ROM;
 // Number of the ROM in the database or 0xFFFF if unknown
 
+PCE_LOCAL uint32 ROM_CRC;
+// CRC of the ROM, used to look it up in the database
+
 uchar debug_on_beginning = 0;
 // Do we have to set a bp on the reset IP
 
 uchar CD_emulation = 0;
 // Do we emulate CD ( == 1)
 //                      or  ISO file     ( == 2)
-//                      or  ISQ file     ( == 3)
+//                      or  ISQ file     ( == 3, CISO packed ISO)
 //                      or  plain BIN file ( == 4)
 //                      or  HCD ( == 5)
 
@@ -268,17 +293,31 @@ const char *joymap_reverse[J_MAX] = {
 
 uint32 packed_iso_filesize = 0;
 
+//! Part of iso_FILE holding the image, when it's stored in a zip archive
+uint32 iso_data_offset = 0;
+uint32 iso_data_size = 0;
+
 uint32 ISQ_position = 0;
 
 // struct cdrom_tocentry pce_cd_tocentry;
 
 uchar nb_max_track = 24;		//(NO MORE BCD!!!!!)
 
+//! Boundaries of each track, indexed by track number, see find_cd_track
+static uint32 cd_track_begin[0x100];
+static uint32 cd_track_end[0x100];
+
+//! Non zero when CD_track comes from a cue sheet instead of fill_cd_info
+static uchar cd_toc_from_cue = 0;
+
+//! Offset of the data track of a BIN image without cue sheet
+static long bin_data_offset = 0;
+
 //extern char    *pCartName;
 
 //extern char snd_bSound;
 
-uint32 timer_60 = 0;
+PCE_LOCAL uint32 timer_60 = 0;
 // how many times do the interrupt have been called
 
 int UPeriod = 0;
@@ -322,11 +361,6 @@ check_char(char *s, char c)
 uint32
 interrupt_60hz(uint32 interval, void *param)
 {
-	/* Refresh freezed values in RAM */
-	for (can_blit = 0; can_blit < current_freezed_values; can_blit++)
-		RAM[list_to_freeze[can_blit].position] =
-			list_to_freeze[can_blit].value;
-
 	/* Make the system understand it can blit */
 	can_blit = 1;
 
@@ -360,12 +394,83 @@ init_log_file()
 extern int op6502_nb;
 
 
+//! Build the lsn to track lookup, once the TOC is known
+static void
+build_cd_track_index(void)
+{
+	int track;
+
+	for (track = 1; track <= nb_max_track; track++) {
+		cd_track_begin[track] = CD_track[track].beg_lsn;
+		cd_track_end[track] = CD_track[track].beg_lsn + CD_track[track].length;
+	}
+}
+
+
+//! Track holding lsn, 0 if none
+uchar
+find_cd_track(uint32 lsn)
+{
+	int low = 1, high = nb_max_track, middle;
+
+	// Last track beginning at or before lsn
+	while (low < high) {
+		middle = (low + high + 1) / 2;
+		if (cd_track_begin[middle] <= lsn)
+			low = middle;
+		else
+			high = middle - 1;
+	}
+
+	if (lsn < cd_track_begin[low] || lsn >= cd_track_end[low])
+		return 0;
+
+	return low;
+}
+
+
+/*
+ * Locate the first sector of the data track of a BIN image without cue
+ * sheet. Only the start of each raw sector is looked at, for the mode 1
+ * sync pattern followed by the CD header. Returns -1 if there is none.
+ */
+static long
+find_BIN_data_track(void)
+{
+	static const uchar sync[12] =
+		{ 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0x00
+	};
+	uchar header[16 + 32];
+	long position = 0;
+
+	MESSAGE_INFO("No cue sheet for %s, looking for the data track\n",
+				 ISO_filename);
+
+	while (fseek(iso_FILE, position, SEEK_SET) == 0
+		   && fread(header, sizeof(header), 1, iso_FILE) == 1) {
+		if (!memcmp(header, sync, 12) && header[15] == 1
+			&& !memcmp(header + 16, ISO_header, 32))
+			return position + 16;
+		position += 2352;
+	}
+
+	MESSAGE_ERROR("No data track found in %s\n", ISO_filename);
+	return -1;
+}
+
+
 void
 fill_cd_info()
 {
 	uchar Min, Sec, Fra;
 	uchar current_track;
 
+	if (cd_toc_from_cue) {
+		build_cd_track_index();
+		return;
+	}
+
 	// Track 1 is almost always a audio avertising track
 	// 30 sec. seems usual
 
@@ -399,13 +504,18 @@ fill_cd_info()
 
 	switch (CD_emulation) {
 	case 2:
-		CD_track[0x02].length = filesize(iso_FILE) / 2048;
+		CD_track[0x02].length =
+			(iso_data_size ? iso_data_size : filesize(iso_FILE)) / 2048;
+		CD_track[0x02].file_offset = iso_data_offset;
+		CD_track[0x02].sector_size = 2048;
 		break;
 	case 3:
 		CD_track[0x02].length = packed_iso_filesize / 2048;
 		break;
 	case 4:
 		CD_track[0x02].length = 140000;
+		CD_track[0x02].file_offset = bin_data_offset;
+		CD_track[0x02].sector_size = 2352;
 		break;
 	default:
 		break;
@@ -413,8 +523,7 @@ fill_cd_info()
 
 	// Now most track are audio
 
-	for (current_track = 3; current_track < bcdbin[nb_max_track];
-		 current_track++) {
+	for (current_track = 3; current_track < nb_max_track; current_track++) {
 
 		Fra = CD_track[current_track - 1].length % CD_FRAMES;
 		Sec = (CD_track[current_track - 1].length / CD_FRAMES) % CD_SECS;
@@ -464,7 +573,8 @@ fill_cd_info()
 	/* Thank to Nyef for having localised a little bug there */
 	switch (CD_emulation) {
 	case 2:
-		CD_track[nb_max_track].length = filesize(iso_FILE) / 2048;
+		CD_track[nb_max_track].length =
+			(iso_data_size ? iso_data_size : filesize(iso_FILE)) / 2048;
 		break;
 	case 3:
 		CD_track[nb_max_track].length = packed_iso_filesize / 2048;
@@ -475,74 +585,77 @@ fill_cd_info()
 	default:
 		break;
 	}
+
+	build_cd_track_index();
 }
 
 
-void
-read_sector_BIN(uchar * p, uint32 sector)
+//! Copy the 2048 bytes of sector index of the data track file, counted
+//! from the beginning of track 2
+static void
+read_data_track_sector(uchar * p, uint32 index)
 {
-	static int first_read = 1;
-	static long second_track_sector = 0;
-	int result;
-
-
-	if (first_read) {
-		uchar found = 0, dummy;
-		int index_in_header = 0;
-		unsigned long position;
-
-		fseek(iso_FILE, 0, SEEK_SET);
-
-		while ((!found) && (!feof(iso_FILE))) {
-			dummy = getc(iso_FILE);
-			if (dummy == ISO_header[0]) {
-				position = ftell(iso_FILE);
-				index_in_header = 1;
-				while ((index_in_header < 0x800)
-					   && (getc(iso_FILE) ==
-						   ISO_header[index_in_header++]));
-
-				if (index_in_header == 0x800) {
-					found = 1;
-					second_track_sector = ftell(iso_FILE) - 0x800;
-				}
+#if defined(__linux__)
+	size_t offset = CD_track[2].file_offset
+		+ (size_t) index * CD_track[2].sector_size;
 
-				fseek(iso_FILE, position, SEEK_SET);
-			}
-		}
+	if (offset + 2048 > iso_map_size) {
+		MESSAGE_ERROR("Sector %d is past the end of the image\n", index);
+		memset(p, 0, 2048);
+		return;
+	}
 
-		first_read = 0;
+	memcpy(p, iso_map + offset, 2048);
+#else
+	cd_cache_read(p, index);
+#endif
+}
 
-	}
 
-	for (result = bcdbin[nb_max_track]; result > 0x01; result--) {
-		if ((sector >= CD_track[binbcd[result]].beg_lsn)
-			&& (sector <= CD_track[binbcd[result]].beg_lsn
-				+ CD_track[binbcd[result]].length))
-			break;
-	}
+void
+read_sector_BIN(uchar * p, uint32 sector)
+{
+	int i, result = find_cd_track(sector);
 
-	if (result != 0x02) {
+	// Data tracks stored in the same file as track 2 can be read
+	if (!result || CD_track[result].type != 4
+		|| CD_track[result].sector_size != CD_track[2].sector_size
+		|| strcmp(CD_track[result].filename, CD_track[2].filename)) {
 		MESSAGE_ERROR("Read on non-track 2\n");
 		TRACE("Track %d asked, sector number: 0x%X\n",
 			  result, pce_cd_sectoraddy);
-		exit(-10);
+
+		for (i = 0; i < 2048; i += 4)
+			*(uint32 *) & p[i] = 0xDEADBEEF;
+		return;
 	}
 #if ENABLE_TRACING
 	TRACE("BIN: Loading sector number %d\n", pce_cd_sectoraddy);
 #endif
 
-	fseek(iso_FILE, second_track_sector
-		  + (sector - CD_track[binbcd[result]].beg_lsn) * 2352, SEEK_SET);
-	fread(p, 2048, 1, iso_FILE);
-
+	read_data_track_sector(p, (CD_track[result].file_offset
+							   - CD_track[2].file_offset)
+						   / CD_track[2].sector_size
+						   + sector - CD_track[result].beg_lsn);
 }
 
 
 void
 read_sector_ISQ(uchar * p, uint32 sector)
 {
-	// Only for allegro?
+	int result = find_cd_track(sector);
+
+	if (result != 0x02) {
+		int i;
+		MESSAGE_ERROR("Read on non-track 2\n");
+		TRACE("Track %d asked\nsector : 0x%X", result, pce_cd_sectoraddy);
+
+		for (i = 0; i < 2048; i += 4)
+			*(uint32 *) & p[i] = 0xDEADBEEF;
+		return;
+	}
+
+	isq_read_sector(p, sector - CD_track[result].beg_lsn);
 }
 
 
@@ -583,14 +696,7 @@ read_sector_CD(uchar * p, uint32 sector)
 void
 read_sector_ISO(uchar * p, uint32 sector)
 {
-	int result;
-
-	for (result = nb_max_track; result > 0x01; result--) {
-		if ((sector >= CD_track[result].beg_lsn)
-			&& (sector <=
-				CD_track[result].beg_lsn + CD_track[result].length))
-			break;
-	}
+	int result = find_cd_track(sector);
 
 #if ENABLE_TRACING_CD
 	TRACE("CDRom2: Loading ISO sector %d...\n"
@@ -634,8 +740,7 @@ read_sector_ISO(uchar * p, uint32 sector)
 		}
 	}
 
-	fseek(iso_FILE, (sector - CD_track[result].beg_lsn) * 2048, SEEK_SET);
-	fread(p, 2048, 1, iso_FILE);
+	read_data_track_sector(p, sector - CD_track[result].beg_lsn);
 
 }
 
@@ -650,9 +755,6 @@ read_sector_dummy(uchar * p, uint32 sector)
 void
 pce_cd_read_sector(void)
 {
-	// Reduce volume to avoid sound stutter during CD access
-	osd_snd_set_volume(0);
-
 #if ENABLE_TRACING_CD
 	TRACE("CDRom2: %s reading sector %d (via CDEmulation mode %d)\n",
 		  __func__, pce_cd_sectoraddy, CD_emulation);
@@ -706,31 +808,40 @@ pce_cd_read_sector(void)
 
 	pce_cd_read_datacnt = 2048;
 	cd_read_buffer = cd_sector_buffer;
+}
+
 
-	// raise volume back to original value
-	osd_snd_set_volume(gen_vol);
+void
+pce_cd_prefetch_sector(uint32 sector)
+{
+#if !defined(__linux__)
+	if ((CD_emulation == 2 || CD_emulation == 4)
+		&& sector >= CD_track[2].beg_lsn
+		&& sector < CD_track[2].beg_lsn + CD_track[2].length)
+		cd_cache_prefetch(sector - CD_track[2].beg_lsn);
+#endif
 }
 
 
 void
 issue_ADPCM_dma(void)
 {
-#ifndef FINAL_RELEASE
-	fprintf(stderr, "Will make DMA transfer\n");
-	Log("ADPCM DMA will begin\n");
+#if ENABLE_TRACING_CD
+	TRACE("CDRom2: ADPCM DMA of %d sectors to 0x%X\n", cd_sectorcnt,
+		  io.adpcm_dmaptr);
 #endif
 
-	while (cd_sectorcnt--) {
-		memcpy(PCM + io.adpcm_dmaptr, cd_read_buffer, pce_cd_read_datacnt);
-		cd_read_buffer = NULL;
-		io.adpcm_dmaptr += pce_cd_read_datacnt;
+	// No READ command feeding the transfer
+	if (!pce_cd_drive_busy) {
 		pce_cd_read_datacnt = 0;
-		pce_cd_read_sector();
+		cd_read_buffer = NULL;
+		pce_cd_adpcm_trans_done = 1;
+		return;
 	}
 
-	pce_cd_read_datacnt = 0;
-	pce_cd_adpcm_trans_done = 1;
-	cd_read_buffer = NULL;
+	// Completed from the scanline handler, pce_cd_adpcm_trans_done is set
+	// once the last sector is in
+	pce_cd_drive_dma();
 }
 
 /*
@@ -858,8 +969,8 @@ search_possible_syscard()
 			TRACE("Checking for CD syscard at : %s\n", temp_buffer);
 			if ((f = fopen(temp_buffer, "rb")) != NULL) {
 				fclose(f);
-				strncpy(syscard_filename, temp_buffer,
-						sizeof(syscard_filename));
+				// A pointer now, its sizeof cut the name to 7 characters
+				strcpy(syscard_filename, temp_buffer);
 				MESSAGE_INFO("Found CD system card at %s\n",
 							 syscard_filename);
 				return syscard_filename;
@@ -900,6 +1011,8 @@ CartInit(char* name)
 	MESSAGE_INFO("Opening %s...\n", name);
 	uchar CDemulation = 0;
 
+	iso_data_offset = iso_data_size = 0;
+
 	if (CD_emulation == 1 || strstr(name, "/dev/disk/atapi/")
 		|| strstr(name, "/dev/sr")) {
 		CDemulation = 1;
@@ -931,7 +1044,7 @@ CartInit(char* name)
 		strcpy(ISO_filename, name);
 
 		search_syscard();
-	} else if (strcasestr(name, ".ISQ")) {
+	} else if (strcasestr(name, ".ISQ") || strcasestr(name, ".CSO")) {
 		// Enable ISQ support
 		CDemulation = 3;
 		MESSAGE_INFO("Using CD ISQ emulation\n");
@@ -948,6 +1061,20 @@ CartInit(char* name)
 		// Load correct ISO filename
 		strcpy(ISO_filename, name);
 
+		search_syscard();
+	} else if (strcasestr(name, ".CUE")) {
+		// BIN image described by a cue sheet
+		CDemulation = 4;
+		MESSAGE_INFO("Using CD BIN emulation with cue sheet\n");
+
+		// The BIN filename is read from the sheet at reset, the sheet is
+		// checked now so that a bad one is reported before loading anything
+		if (fill_CUE_info(name) <= 0) {
+			MESSAGE_ERROR("Invalid cue sheet %s\n", name);
+			return CART_INIT_ERROR;
+		}
+		strcpy(ISO_filename, name);
+
 		search_syscard();
 	} else if (strcasestr(name, ".ZIP")) {
 		char filename_in_archive[PATH_MAX];
@@ -960,41 +1087,41 @@ CartInit(char* name)
 
 		if (result == ZIP_ERROR) {
 			MESSAGE_ERROR("ZIP file error!\n");
-			return 1;
+			return CART_INIT_ERROR;
 		} else if (result == ZIP_HAS_NONE) {
 			MESSAGE_ERROR("No valid game files found in ZIP file!\n");
-			return 1;
+			return CART_INIT_ERROR;
 		}
 
 		if (strcmp(filename_in_archive, "")) {
 			Log("Found %s in %s\n", filename_in_archive, name);
 			if (result == ZIP_HAS_PCE) {
+#if defined(SHARED_MEMORY)
 				size_t unzipped_rom_size = 0;
 				char* unzipped_rom = zipmgr_extract_to_memory(name,
 					filename_in_archive, &unzipped_rom_size);
 
 				if (unzipped_rom == NULL || unzipped_rom_size == 0) {
 					MESSAGE_ERROR("Error expanding rom to memory!\n");
-					return 1;
+					return CART_INIT_ERROR;
 				}
 
 				MESSAGE_INFO("unzipped rom size: %d\n", unzipped_rom_size);
 
 				ROM_size = unzipped_rom_size / 0x2000;
 
-#if defined(SHARED_MEMORY)
 				shm_rom_handle = shmget((key_t) SHM_ROM_HANDLE,
 					unzipped_rom_size, IPC_CREAT | IPC_EXCL | 0666);
 	
 				if (shm_rom_handle == -1) {
 					fprintf(stderr, "Couldn't get shared memory (%d bytes)\n",
 						unzipped_rom_size);
-					return 1;
+					return CART_INIT_ERROR;
 				} else {
 					ROM = (char *)shmat(shm_rom_handle, NULL, 0);
 					if (ROM == NULL) {
 						fprintf(stderr, "Couldn't attach shared memory\n");
-						return 1;
+						return CART_INIT_ERROR;
 					} else {
 						// Copy into the shared memory, by skipping an eventual header
 						memcpy(ROM, unzipped_rom + (unzipped_rom_size & 0x1FF),
@@ -1003,21 +1130,39 @@ CartInit(char* name)
 					}
 				}
 #else
-				if ((unzipped_rom_size & 0x1FFF) == 0) {
-					/* No header */
-					ROM = unzipped_rom;
-				} else {
-					ROM = malloc(unzipped_rom_size & ~0x1FFF);
-					memcpy(ROM, unzipped_rom + (unzipped_rom_size & 0x1FFF),
-						unzipped_rom_size & ~0x1FFF);
-					free(unzipped_rom);
+				size_t rom_size = 0;
+
+				// Inflated straight into its final place, header skipped
+				ROM = zipmgr_extract_rom(name, filename_in_archive, &rom_size);
+
+				if (ROM == NULL) {
+					MESSAGE_ERROR("Error expanding rom to memory!\n");
+					return CART_INIT_ERROR;
 				}
+
+				MESSAGE_INFO("unzipped rom size: %d\n", rom_size);
+
+				ROM_size = rom_size / 0x2000;
+				// The archive can't be read again for CRC_file
+				ROM_crc = CRC_buffer(ROM, rom_size);
+				ROM_crc_valid = 1;
 				return 0;
 #endif
+			} else if (result == ZIP_HAS_ISO
+				&& zipmgr_locate_stored(name, filename_in_archive,
+					&iso_data_offset, &iso_data_size)) {
+				// Stored images are read in place, without extracting them
+				CDemulation = 2;
+				MESSAGE_INFO("Using CD ISO emulation from %s\n",
+					filename_in_archive);
+
+				strcpy(ISO_filename, name);
+
+				search_syscard();
 			} else {
 				if (zipmgr_extract_to_disk(name, tmp_basepath)) {
-					MESSAGE_ERROR("Error eixtracting zipfile\n");
-					return 1;
+					MESSAGE_ERROR("Error extracting zipfile\n");
+					return CART_INIT_ERROR;
 				}
 				char tmpGame[PATH_MAX];
 				snprintf(tmpGame, PATH_MAX, "%s%s%s", tmp_basepath, PATH_SLASH,
@@ -1054,8 +1199,16 @@ CartInit(char* name)
 int
 CartLoad(char *name)
 {
+	int bank;
+
+	ROM_crc_valid = 0;
 	CD_emulation = CartInit(name);
 
+	if (CD_emulation == CART_INIT_ERROR) {
+		CD_emulation = 0;
+		return -1;
+	}
+
 	if (cart_name != name) {
 		// Avoids warning when copying passing cart_name as parameter
 		#warning find where this weird call is done
@@ -1072,6 +1225,10 @@ CartLoad(char *name)
 	// find file size
 	fseek(fp, 0, SEEK_END);
 	int fsize = ftell(fp);
+	int header = fsize & 0x1fff;
+
+	// CRC_file skips headers below 4KB, the CRC can then use the same bytes
+	ROM_crc_valid = !(header & 0x1000);
 
 	// ajust var if header present
 	fseek(fp, fsize & 0x1fff, SEEK_SET);
@@ -1091,12 +1248,32 @@ CartLoad(char *name)
 			fprintf(stderr, "Couldn't attach shared memory\n");
 	}
 
+#elif defined(__linux__)
+	ROM_map = (uchar *) mmap(NULL, fsize + header, PROT_READ | PROT_WRITE,
+							 MAP_PRIVATE, fileno(fp), 0);
+	if (ROM_map == MAP_FAILED) {
+		ROM_map = NULL;
+		ROM = (uchar *) malloc(fsize);
+	} else {
+		ROM_map_size = fsize + header;
+		ROM = ROM_map + header;
+	}
 #else
 	//ROM = (uchar *)malloc(fsize);
 	ROM = (uchar *)my_special_alloc(false, 1, fsize);
 #endif
 	ROM_size = fsize / 0x2000;
-	fread(ROM, 1, fsize, fp);
+	ROM_crc = 0;
+#if defined(__linux__) && !defined(SHARED_MEMORY)
+	if (ROM_map)
+		ROM_crc = CRC_buffer(ROM, fsize);
+	else
+#endif
+	// A bank at a time, its CRC taken while it is still in the cache
+	for (bank = 0; bank < ROM_size; bank++) {
+		fread(ROM + bank * 0x2000, 1, 0x2000, fp);
+		ROM_crc = CRC_update(ROM_crc, ROM + bank * 0x2000, 0x2000);
+	}
 
 	fclose(fp);
 
@@ -1104,6 +1281,52 @@ CartLoad(char *name)
 }
 
 
+#ifdef MY_USE_FAST_RAM
+//! Internal RAM left for the tasks stacks and the drivers, as for the CD RAM
+#define HOT_BANK_RAM_RESERVE 0x8000
+
+//! Copies in internal RAM of the banks the rom database marks as hot
+static PCE_LOCAL uchar *hot_banks[32];
+
+static void
+unpin_hot_banks(void)
+{
+	int bank;
+
+	for (bank = 0; bank < 32; bank++) {
+		free(hot_banks[bank]);
+		hot_banks[bank] = NULL;
+	}
+}
+
+
+static void
+pin_hot_banks(uint32 banks)
+{
+	int bank;
+
+	// ResetPCE mapped the rom again, the former copies are unused
+	unpin_hot_banks();
+
+	for (bank = 0; bank < 32; bank++) {
+		if (!(banks & (1u << bank)))
+			continue;
+
+		if (my_special_free_largest(true) < 0x2000 + HOT_BANK_RAM_RESERVE
+			|| !(hot_banks[bank] = (uchar *) my_special_alloc_try(true, 1, 0x2000)))
+			break;
+
+		memcpy(hot_banks[bank], ROMMapR[bank], 0x2000);
+		// Writes follow, so that reads see them as with the rom
+		if (ROMMapW[bank] == ROMMapR[bank])
+			ROMMapW[bank] = hot_banks[bank];
+		ROMMapR[bank] = hot_banks[bank];
+		MESSAGE_INFO("Hot bank 0x%02X pinned in fast memory\n", bank);
+	}
+}
+#endif
+
+
 int
 ResetPCE()
 {
@@ -1220,14 +1443,68 @@ ResetPCE()
 	}
 
 
-	if ((CD_emulation == 2) || (CD_emulation == 4)) {
+	if ((CD_emulation >= 2) && (CD_emulation <= 4)) {
+
+		// A BIN image can come with a cue sheet, given or named after it
+		cd_toc_from_cue = 0;
+		if (CD_emulation == 4) {
+			int cue;
+
+			// A sheet given by name has to be there
+			if (strcasestr(ISO_filename, ".CUE")) {
+				if (!(cue = fill_CUE_info(ISO_filename)))
+					cue = -1;
+			} else
+				cue = search_CUE_info(ISO_filename);
+
+			if (cue < 0) {
+				MESSAGE_ERROR("Invalid cue sheet for %s\n", ISO_filename);
+				return 1;
+			}
+
+			cd_toc_from_cue = cue;
+			if (cd_toc_from_cue)
+				strcpy(ISO_filename, CD_track[2].filename);
+		}
 
 		if (!(iso_FILE = fopen(ISO_filename, "rb"))) {
 			MESSAGE_ERROR("Couldn't read ISO at %s\n", ISO_filename);
 			return 1;
 		}
 
+		if (CD_emulation == 3) {
+			if (!isq_open(iso_FILE))
+				return 1;
+			packed_iso_filesize = isq_size();
+		}
+
+		// Searched once, fill_cd_info is run again by the CD commands
+		if (CD_emulation == 4 && !cd_toc_from_cue
+			&& (bin_data_offset = find_BIN_data_track()) < 0)
+			return 1;
+
 		fill_cd_info();
+
+#if defined(__linux__)
+		if (CD_emulation != 3) {
+			iso_map_size = filesize(iso_FILE);
+			iso_map = (uchar *) mmap(NULL, iso_map_size, PROT_READ,
+									 MAP_SHARED, fileno(iso_FILE), 0);
+			if (iso_map == MAP_FAILED) {
+				MESSAGE_ERROR("Couldn't map ISO at %s\n", ISO_filename);
+				iso_map = NULL;
+				return 1;
+			}
+		}
+#else
+		// Packed images have their own cache of unpacked hunks
+		if (CD_emulation != 3)
+			cd_cache_open(iso_FILE, CD_track[2].file_offset,
+						  CD_track[2].sector_size);
+#endif
+
+		pce_cd_drive_stop();
+		cdda_init();
 	}
 
 	TRACE("CD Emulation is %d\n", CD_emulation);
@@ -1342,21 +1619,16 @@ InitPCE(char *name)
 	/* TEST */
 	io.screen_w = 256;
 
-	uint32 CRC = CRC_file(rom_file_name);
+	ROM_CRC = ROM_crc_valid ? ROM_crc : CRC_file(rom_file_name);
 
 	/* I'm doing it only here 'coz cartload set
 	   true_file_name       */
 
-	NO_ROM = 0xFFFF;
-
-	int index;
-	for (index = 0; index < KNOWN_ROM_COUNT; index++) {
-		if (CRC == kKnownRoms[index].CRC)
-			NO_ROM = index;
-	}
+	int index = romdb_find(ROM_CRC);
+	NO_ROM = index < 0 ? 0xFFFF : index;
 
 	if (NO_ROM == 0xFFFF)
-		printf("ROM not in database: CRC=%lx\n", CRC);
+		printf("ROM not in database: CRC=%lx\n", ROM_CRC);
 
 	memset(WRAM, 0, 0x2000);
 	WRAM[0] = 0x48;				/* 'H' */
@@ -1512,6 +1784,15 @@ InitPCE(char *name)
 	}
 #endif
 
+	// Street Fighter II: writes to ROM switch banks 0x40-0x7F, so ROM pages
+	// are write trapped. Reads stay direct, a switch only rewrites ROMMapR.
+	sf2_mapper = ROM_size > 0x80;
+	if (sf2_mapper) {
+		MESSAGE_INFO("Special Rom: Street Fighter II mapper\n");
+		for (i = 0; i < 0x80; i++)
+			ROMMapW[i] = IOAREA;
+	}
+
 	if (NO_ROM != 0xFFFF) {
 		MESSAGE_INFO("Rom Name: %s\n",
 			(kKnownRoms[NO_ROM].Name) ? kKnownRoms[NO_ROM].Name : "Unknown");
@@ -1567,6 +1848,13 @@ InitPCE(char *name)
 			ROMMapW[i] = cd_extra_super_mem + 0x2000 * (i - 0x68);
 		}
 
+		// The Arcade Card ports are the only trapped banks
+		if (option.want_arcade_card_emulation)
+			for (i = 0x40; i < 0x44; i++) {
+				ROMMapR[i] = IOAREA;
+				ROMMapW[i] = IOAREA;
+			}
+
 	}
 
 	ROMMapR[0xF7] = WRAM;
@@ -1610,46 +1898,12 @@ InitPCE(char *name)
 
 	}
 
-	if ((NO_ROM != 0xFFFF) && (kKnownRoms[NO_ROM].Flags & CD_SYSTEM)) {
-		uint16 offset = 0;
-		uchar new_val = 0;
+	if ((NO_ROM != 0xFFFF) && kKnownRoms[NO_ROM].PatchOffset)
+		ROMMapW[0xE1][kKnownRoms[NO_ROM].PatchOffset & 0x1fff] =
+			kKnownRoms[NO_ROM].PatchValue;
 
-		switch(kKnownRoms[NO_ROM].CRC) {
-			case 0X3F9F95A4:
-				// CD-ROM SYSTEM VER. 1.00
-				offset = 56254;
-				new_val = 17;
-				break;
-			case 0X52520BC6:
-			case 0X283B74E0:
-				// CD-ROM SYSTEM VER. 2.00
-				// CD-ROM SYSTEM VER. 2.10
-				offset = 51356;
-				new_val = 128;
-				break;
-			case 0XDD35451D:
-			case 0XE6F16616:
-				// CD ROM 2 SYSTEM 3.0
-				// SUPER CD-ROM2 SYSTEM VER. 3.00
-				// SUPER CD-ROM2 SYSTEM VER. 3.00
-				offset = 51401;
-				new_val = 128;
-				break;
-		}
-
-		if (offset > 0)
-			ROMMapW[0xE1][offset & 0x1fff] = new_val;
-	}
-#ifdef MY_REALLOC_MEMORY_SIDEARMS
-	{ // SIDE Arms: 46,5 -> 47
-    // exe_go: bank_set: 7,0 -> 3F89BDA4
-    void *mem_fast = my_special_alloc(true, 1, 0x2000);
-    int nr = 7;
-    memcpy(mem_fast, ROMMapR[0], 0x2000);
-    printf("FAST MEM: %X -> %X\n", ROMMapR[0], mem_fast);
-    ROMMapR[0] = mem_fast;
-    ROMMapW[0] = mem_fast;
-    }
+#ifdef MY_USE_FAST_RAM
+	pin_hot_banks(NO_ROM != 0xFFFF ? kKnownRoms[NO_ROM].HotBanks : 0);
 #endif
 
 	return 0;
@@ -1673,6 +1927,16 @@ TrashPCE()
 	char backupmem[PATH_MAX];
 	snprintf(backupmem, PATH_MAX, "%s/backupmem.bin", config_basepath);
 
+	// Needs the rom mapped to disassemble the hotspots
+	profile_dump();
+	opcode_stats_log();
+
+	cheat_search_stop();
+	current_freezed_values = 0;
+#ifdef MY_USE_FAST_RAM
+	unpin_hot_banks();
+#endif
+
 	// Save the backup ram into file
 	if (!(fp = fopen(backupmem, "wb"))) {
 		memset(WRAM, 0, 0x2000);
@@ -1695,8 +1959,18 @@ TrashPCE()
 	if (CD_emulation == 1)
 		osd_cd_close();
 
-	if ((CD_emulation == 2) || (CD_emulation == 4))
+	if ((CD_emulation >= 2) && (CD_emulation <= 4)) {
+		cdda_shutdown();
+#if defined(__linux__)
+		if (iso_map)
+			munmap(iso_map, iso_map_size);
+		iso_map = NULL;
+#else
+		cd_cache_close();
+#endif
+		isq_close();
 		fclose(iso_FILE);
+	}
 
 	if (CD_emulation == 5)
 		HCD_shutdown();
@@ -1709,10 +1983,17 @@ TrashPCE()
 #if defined(SHARED_MEMORY)
 		if (shmctl(shm_rom_handle, IPC_RMID, NULL) == -1)
 			fprintf(stderr, "Couldn't destroy shared memory\n");
+#elif defined(__linux__)
+		if (ROM_map)
+			munmap(ROM_map, ROM_map_size);
+		else
+			free(ROM);
+		ROM_map = NULL;
 #else
 		free(ROM);
 #endif
-
+		// CartLoad keeps a rom already there, as extracted from a zip
+		ROM = NULL;
 	}
 
 	if (PopRAM)
@@ -1759,7 +2040,7 @@ FILE *out_snd;
 // DRAM_ATTR
 // WORD_ALIGNED_ATTR
 
-#define VAR_PREFIX DRAM_ATTR WORD_ALIGNED_ATTR
+#define VAR_PREFIX DRAM_ATTR WORD_ALIGNED_ATTR PCE_LOCAL
 
 VAR_PREFIX pair IO_VDC_00_MAWR ;
 VAR_PREFIX pair IO_VDC_01_MARR ;
@@ -45,6 +45,8 @@
 
 
 uint32 CRC_file(char *);
+//! Returned by CartInit when the media can't be used
+#define CART_INIT_ERROR 0xFF
 uchar CartInit(char* name);
 int CartLoad(char *name);
 int ResetPCE();
@@ -54,6 +56,7 @@ int32 Joysticks(void);
 uint32 msf2nb_sect(uchar min, uchar sec, uchar fra);
 void fill_cd_info();
 void nb_sect2msf(uint32 lsn, uchar * min, uchar * sec, uchar * frm);
+uchar find_cd_track(uint32 lsn);
 void delete_file_tmp(char *name, int dummy, int dummy2);
 #ifndef MY_INLINE
 uchar TimerInt();
@@ -64,6 +67,8 @@ int InitPCE(char *name);
 void TrashPCE();
 int RunPCE(void);
 void pce_cd_read_sector(void);
+//! Let the sector cache load a sector before it's read
+void pce_cd_prefetch_sector(uint32 sector);
 void issue_ADPCM_dma(void);
 
 void SetPalette(void);
@@ -158,9 +163,21 @@ extern uchar CDBIOS_replace[0x4d][2];
 extern uchar use_eagle;
 // Do we use eagle ?
 
-extern uint32 timer_60;
+extern PCE_LOCAL uint32 timer_60;
 // how many times do the interrupt have been called
 
+extern PCE_LOCAL uchar *ROM;
+// the rom, without its header
+
+extern PCE_LOCAL int ROM_size;
+// number of blocks of 0x2000 bytes in the rom
+
+extern PCE_LOCAL uint16 NO_ROM;
+// number of the rom in the database or 0xFFFF if unknown
+
+extern PCE_LOCAL uint32 ROM_CRC;
+// CRC of the rom, computed by InitPCE
+
 extern uchar bcdbin[0x100];
 
 extern uchar binbcd[0x100];
@@ -187,6 +204,9 @@ struct hugo_options {
 	int want_arcade_card_emulation;
 	int want_supergraphx_emulation;
 	int want_television_size_emulation;
+	//! CD_READ calls run the system card code on the emulated drive
+	//! instead of copying whole sectors at the call
+	int want_cd_read_lle;
 	uint16 window_size;
 	uint32 want_snd_freq;
 	uint32 wanted_hardware_format;
@@ -235,6 +255,9 @@ typedef struct {
 	hcd_source_type source_type;
 	char filename[256];
 
+	uint32 file_offset;			/* user data of the first sector in filename */
+	uint16 sector_size;			/* 2048 or 2352, 0 if unknown */
+
 	uint32 patch_number;
 	uint32 subtitle_number;
 
@@ -325,6 +348,16 @@ extern uchar can_write_debug;
 
 #include "hcd.h"
 
+#include "cdda.h"
+
+#include "movie.h"
+
+#include "rollback.h"
+
+#include "profile.h"
+
+#include "opcode_stats.h"
+
 
 #if defined(SEAL_SOUND)
 #include </djgpp/audio/include/audio.h>	// SEAL include
@@ -338,28 +371,28 @@ extern uchar can_write_debug;
 
 #ifdef MY_VDC_VARS
 
-extern pair IO_VDC_00_MAWR ;
-extern pair IO_VDC_01_MARR ;
-extern pair IO_VDC_02_VWR  ;
-extern pair IO_VDC_03_vdc3 ;
-extern pair IO_VDC_04_vdc4 ;
-extern pair IO_VDC_05_CR   ;
-extern pair IO_VDC_06_RCR  ;
-extern pair IO_VDC_07_BXR  ;
-extern pair IO_VDC_08_BYR  ;
-extern pair IO_VDC_09_MWR  ;
-extern pair IO_VDC_0A_HSR  ;
-extern pair IO_VDC_0B_HDR  ;
-extern pair IO_VDC_0C_VPR  ;
-extern pair IO_VDC_0D_VDW  ;
-extern pair IO_VDC_0E_VCR  ;
-extern pair IO_VDC_0F_DCR  ;
-extern pair IO_VDC_10_SOUR ;
-extern pair IO_VDC_11_DISTR;
-extern pair IO_VDC_12_LENR ;
-extern pair IO_VDC_13_SATB ;
-extern pair IO_VDC_14      ;
-extern pair *IO_VDC_active_ref;
+extern PCE_LOCAL pair IO_VDC_00_MAWR ;
+extern PCE_LOCAL pair IO_VDC_01_MARR ;
+extern PCE_LOCAL pair IO_VDC_02_VWR  ;
+extern PCE_LOCAL pair IO_VDC_03_vdc3 ;
+extern PCE_LOCAL pair IO_VDC_04_vdc4 ;
+extern PCE_LOCAL pair IO_VDC_05_CR   ;
+extern PCE_LOCAL pair IO_VDC_06_RCR  ;
+extern PCE_LOCAL pair IO_VDC_07_BXR  ;
+extern PCE_LOCAL pair IO_VDC_08_BYR  ;
+extern PCE_LOCAL pair IO_VDC_09_MWR  ;
+extern PCE_LOCAL pair IO_VDC_0A_HSR  ;
+extern PCE_LOCAL pair IO_VDC_0B_HDR  ;
+extern PCE_LOCAL pair IO_VDC_0C_VPR  ;
+extern PCE_LOCAL pair IO_VDC_0D_VDW  ;
+extern PCE_LOCAL pair IO_VDC_0E_VCR  ;
+extern PCE_LOCAL pair IO_VDC_0F_DCR  ;
+extern PCE_LOCAL pair IO_VDC_10_SOUR ;
+extern PCE_LOCAL pair IO_VDC_11_DISTR;
+extern PCE_LOCAL pair IO_VDC_12_LENR ;
+extern PCE_LOCAL pair IO_VDC_13_SATB ;
+extern PCE_LOCAL pair IO_VDC_14      ;
+extern PCE_LOCAL pair *IO_VDC_active_ref;
 
 #define IO_VDC_reset { \
     IO_VDC_00_MAWR.W=0; \
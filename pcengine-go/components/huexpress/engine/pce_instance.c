@@ -0,0 +1,41 @@
+/***************************************************************************/
+/*                                                                         */
+/*                        Console instance Source File                     */
+/*                                                                         */
+/*     Swaps the engine globals of one emulated console in and out, so     */
+/*     that several consoles can live in the same process.                 */
+/*                                                                         */
+/***************************************************************************/
+
+#include <string.h>
+
+#include "pce_instance.h"
+
+
+void
+pce_instance_store(pce_instance *instance)
+{
+#define PCE_INSTANCE_STORE(type_, name_, dims_) \
+	memcpy(&instance->name_, &name_, sizeof(instance->name_));
+
+	PCE_INSTANCE_STATE(PCE_INSTANCE_STORE)
+
+#undef PCE_INSTANCE_STORE
+}
+
+
+void
+pce_instance_restore(const pce_instance *instance)
+{
+#define PCE_INSTANCE_RESTORE(type_, name_, dims_) \
+	memcpy(&name_, &instance->name_, sizeof(instance->name_));
+
+	PCE_INSTANCE_STATE(PCE_INSTANCE_RESTORE)
+
+#undef PCE_INSTANCE_RESTORE
+
+#ifdef MY_VDC_VARS
+	// Points to a register of this thread, not of the one that stored it
+	IO_VDC_active_set(io.vdc_reg)
+#endif
+}
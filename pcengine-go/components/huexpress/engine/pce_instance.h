@@ -0,0 +1,154 @@
+#ifndef _PCE_INSTANCE_H_
+#define _PCE_INSTANCE_H_
+
+#include "pce.h"
+
+/*
+ * One emulated console. The engine keeps running on its globals, so the hot
+ * path is compiled exactly as before; a pce_instance owns a copy of all of
+ * them and is swapped in and out between frames.
+ *
+ * Host tools define PCE_THREADED_INSTANCES, which makes every variable below
+ * thread local (see PCE_LOCAL): each thread then runs its own console, in
+ * parallel with the others. Several instances can also share one thread by
+ * storing the running one and restoring another.
+ *
+ * The memory blocks (RAM, VRAM, ...) are owned by the instance that hard_init
+ * allocated them for, only pointers are swapped. The CD drive, CD-DA and
+ * audio tasks stay process wide, so a single instance may emulate a CD.
+ */
+
+#define PCE_INSTANCE_STATE(X) \
+	X(struct_hard_pce *, hard_pce, ) \
+	X(IO *, p_io, ) \
+	X(uchar *, RAM, ) \
+	X(uchar *, WRAM, ) \
+	X(uchar *, VRAM, ) \
+	X(uint16 *, SPRAM, ) \
+	X(uchar *, Pal, ) \
+	X(uchar *, VRAM2, ) \
+	X(uchar *, VRAMS, ) \
+	X(uchar *, vchange, ) \
+	X(uchar *, vchanges, ) \
+	X(uint32 *, p_scanline, ) \
+	X(uchar *, PCM, ) \
+	X(uchar *, cd_sector_buffer, ) \
+	X(uchar *, cd_read_buffer, ) \
+	X(uchar *, cd_extra_mem, ) \
+	X(uchar *, cd_extra_super_mem, ) \
+	X(uchar *, ac_extra_mem, ) \
+	X(uint32, pce_cd_read_datacnt, ) \
+	X(uchar, cd_sectorcnt, ) \
+	X(uchar, pce_cd_curcmd, ) \
+	X(uchar *, zp_base, ) \
+	X(uchar *, sp_base, ) \
+	X(uchar *, mmr, ) \
+	X(uchar *, IOAREA, ) \
+	X(uchar **, PageR, ) \
+	X(uchar *, ROMMapR, [256]) \
+	X(uchar **, PageW, ) \
+	X(uchar *, ROMMapW, [256]) \
+	X(uchar *, trap_ram_read, ) \
+	X(uchar *, trap_ram_write, ) \
+	X(uint32 *, p_cyclecount, ) \
+	X(uint32 *, p_cyclecountold, ) \
+	X(int32 *, p_external_control_cpu, ) \
+	X(uint32, cycles_, ) \
+	X(uchar, sf2_mapper, ) \
+	X(uchar *, ROM, ) \
+	X(int, ROM_size, ) \
+	X(uint16, NO_ROM, ) \
+	X(uint32, ROM_CRC, ) \
+	X(uint32, timer_60, ) \
+	X(gfx_context, saved_gfx_context, [MAX_GFX_CONTEXT_SLOT_NUMBER]) \
+	X(int, gfx_need_redraw, ) \
+	X(int, gfx_need_video_mode_change, ) \
+	X(int, UCount, ) \
+	X(uint32 *, spr_init_pos, ) \
+	X(int, ScrollYDiff, ) \
+	X(int, oldScrollX, ) \
+	X(int, oldScrollY, ) \
+	X(int, oldScrollYDiff, ) \
+	X(uchar *, SPM_raw, ) \
+	X(uchar *, SPM, ) \
+	X(int, frame, ) \
+	X(int, sprite_usespbg, ) \
+	X(uchar *, osd_gfx_buffer, ) \
+	X(pce_movie, movie, ) \
+	PCE_INSTANCE_CPU_STATE(X) \
+	PCE_INSTANCE_VDC_STATE(X) \
+	PCE_INSTANCE_LOOP6502_STATE(X)
+
+#if defined(SHARED_MEMORY)
+/* The registers live in hard_pce */
+#define PCE_INSTANCE_CPU_STATE(X) \
+	X(uint16 *, p_reg_pc, ) \
+	X(uchar *, p_reg_a, ) \
+	X(uchar *, p_reg_x, ) \
+	X(uchar *, p_reg_y, ) \
+	X(uchar *, p_reg_p, ) \
+	X(uchar *, p_reg_s, )
+#else
+#define PCE_INSTANCE_CPU_STATE(X) \
+	X(uint32, reg_pc_, ) \
+	X(uchar, reg_a_, ) \
+	X(uchar, reg_x_, ) \
+	X(uchar, reg_y_, ) \
+	X(uchar, reg_p_, ) \
+	X(uchar, reg_s_, )
+#endif
+
+#ifdef MY_VDC_VARS
+/* IO_VDC_active_ref is rebuilt from io.vdc_reg when restoring */
+#define PCE_INSTANCE_VDC_STATE(X) \
+	X(pair, IO_VDC_00_MAWR, ) \
+	X(pair, IO_VDC_01_MARR, ) \
+	X(pair, IO_VDC_02_VWR, ) \
+	X(pair, IO_VDC_03_vdc3, ) \
+	X(pair, IO_VDC_04_vdc4, ) \
+	X(pair, IO_VDC_05_CR, ) \
+	X(pair, IO_VDC_06_RCR, ) \
+	X(pair, IO_VDC_07_BXR, ) \
+	X(pair, IO_VDC_08_BYR, ) \
+	X(pair, IO_VDC_09_MWR, ) \
+	X(pair, IO_VDC_0A_HSR, ) \
+	X(pair, IO_VDC_0B_HDR, ) \
+	X(pair, IO_VDC_0C_VPR, ) \
+	X(pair, IO_VDC_0D_VDW, ) \
+	X(pair, IO_VDC_0E_VCR, ) \
+	X(pair, IO_VDC_0F_DCR, ) \
+	X(pair, IO_VDC_10_SOUR, ) \
+	X(pair, IO_VDC_11_DISTR, ) \
+	X(pair, IO_VDC_12_LENR, ) \
+	X(pair, IO_VDC_13_SATB, ) \
+	X(pair, IO_VDC_14, )
+#else
+#define PCE_INSTANCE_VDC_STATE(X)
+#endif
+
+#ifdef MY_INLINE_GFX_Loop6502
+/* The frame state of Loop6502 is local to exe_go */
+#define PCE_INSTANCE_LOOP6502_STATE(X)
+#else
+#define PCE_INSTANCE_LOOP6502_STATE(X) \
+	X(int, video_dump_countdown, ) \
+	X(int, display_counter, ) \
+	X(int, last_display_counter, ) \
+	X(int, satb_dma_counter, )
+#endif
+
+#define PCE_INSTANCE_FIELD(type_, name_, dims_) type_ name_ dims_;
+
+typedef struct {
+	PCE_INSTANCE_STATE(PCE_INSTANCE_FIELD)
+} pce_instance;
+
+#undef PCE_INSTANCE_FIELD
+
+//! Copy the state of the console running in this thread into instance
+void pce_instance_store(pce_instance *instance);
+
+//! Make instance the console running in this thread, call it between frames
+void pce_instance_restore(const pce_instance *instance);
+
+#endif
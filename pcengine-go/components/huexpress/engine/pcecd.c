@@ -23,8 +23,11 @@
  */
 
 #include "pce.h"
+#include "pcecd.h"
 #include "utils.h"
 
+#include <string.h>
+
 uchar pce_cd_cmdcnt;
 
 uint32 pce_cd_sectoraddy;
@@ -43,6 +46,12 @@ extern uchar pce_cd_adpcm_trans_done;
 
 uchar cd_port_180b = 0;
 
+//! Last value written to $180D, playback starts when its play bit rises
+uchar cd_port_180d = 0;
+
+//! Bytes of adpcm to play, latched from the address by $180D
+uint16 cd_adpcm_length = 0;
+
 uchar cd_fade;
 // the byte set by the fade function
 
@@ -55,6 +64,351 @@ pce_cd_set_sector_address(void)
 }
 
 
+/* Drive state */
+uchar pce_cd_drive_busy = 0;
+
+//! Scanlines counted while a READ command is in progress
+static uint32 cd_drive_clock;
+
+//! Clock value at which the pending sector reaches the data buffer
+static uint32 cd_drive_due;
+
+//! Sector under the laser once the last one has been read
+static uint32 cd_drive_head;
+
+//! A sector is on its way, the data port has nothing to give yet
+static uchar cd_drive_waiting;
+
+//! $1803 interrupt status bits raised by the drive
+static uchar cd_drive_irq;
+
+//! Sectors go to the ADPCM RAM instead of the data port
+static uchar cd_drive_dma;
+
+
+static void
+pce_cd_drive_deliver(void)
+{
+	pce_cd_read_sector();
+
+	cd_drive_head = pce_cd_sectoraddy;
+	cd_drive_waiting = 0;
+	if (!cd_drive_dma)
+		cd_drive_irq |= 0x40;
+
+	// Data in phase, a byte is requested
+	io.cd_port_1800 = 0xC8;
+}
+
+
+//! Wait for sector pce_cd_sectoraddy, the sector cache loads it meanwhile
+static void
+pce_cd_drive_wait(void)
+{
+	if ((int32) (cd_drive_clock - cd_drive_due) >= 0) {
+		pce_cd_drive_deliver();
+		return;
+	}
+
+	pce_cd_read_datacnt = 0;
+	cd_read_buffer = NULL;
+	cd_drive_waiting = 1;
+
+	// Still in the data in phase, without request
+	io.cd_port_1800 = 0x88;
+
+	pce_cd_prefetch_sector(pce_cd_sectoraddy);
+}
+
+
+static void
+pce_cd_drive_seek(void)
+{
+	uint32 distance = pce_cd_sectoraddy > cd_drive_head
+		? pce_cd_sectoraddy - cd_drive_head
+		: cd_drive_head - pce_cd_sectoraddy;
+
+	cd_drive_due = cd_drive_clock + CD_DRIVE_SECTOR_LINES;
+	if (distance)
+		cd_drive_due += CD_DRIVE_SEEK_LINES
+			+ distance / CD_DRIVE_SEEK_SECTORS_PER_LINE;
+
+#if ENABLE_TRACING_CD
+	TRACE("CDRom2: Seek over %d sectors, data in %d lines\n", distance,
+		  cd_drive_due - cd_drive_clock);
+#endif
+
+	cd_drive_irq = 0;
+	pce_cd_drive_busy = 1;
+	pce_cd_drive_wait();
+}
+
+
+//! The last sector was read out, the drive kept on spinning meanwhile
+static void
+pce_cd_drive_next(void)
+{
+	cd_drive_irq &= ~0x40;
+	cd_drive_due += CD_DRIVE_SECTOR_LINES;
+	pce_cd_drive_wait();
+}
+
+
+//! Move the next piece of the delivered sector to the ADPCM RAM
+static void
+pce_cd_drive_dma_chunk(void)
+{
+	uint32 length = MIN(pce_cd_read_datacnt, (uint32) CD_DRIVE_DMA_BYTES);
+	uint32 first = MIN(length, (uint32) (0x10000 - io.adpcm_dmaptr));
+
+	// The DMA pointer wraps in the 64KB of ADPCM RAM
+	memcpy(PCM + io.adpcm_dmaptr, cd_read_buffer, first);
+	memcpy(PCM, cd_read_buffer + first, length - first);
+
+	io.adpcm_dmaptr += length;
+	cd_read_buffer += length;
+	pce_cd_read_datacnt -= length;
+
+	if (pce_cd_read_datacnt)
+		return;
+
+	cd_read_buffer = NULL;
+	if (--cd_sectorcnt) {
+		pce_cd_drive_next();
+		return;
+	}
+
+#if ENABLE_TRACING_CD
+	TRACE("CDRom2: ADPCM DMA over at 0x%X\n", io.adpcm_dmaptr);
+#endif
+
+	// Status phase right away, for code polling $1800 instead of $1802
+	io.cd_port_1800 |= 0x10;
+	pce_cd_curcmd = 0x00;
+	pce_cd_adpcm_trans_done = 1;
+	pce_cd_drive_stop();
+}
+
+
+uchar
+pce_cd_drive_tick(void)
+{
+	cd_drive_clock++;
+
+	if (cd_drive_waiting) {
+		if ((int32) (cd_drive_clock - cd_drive_due) >= 0)
+			pce_cd_drive_deliver();
+	} else if (cd_drive_dma)
+		pce_cd_drive_dma_chunk();
+
+	// Level triggered, held until the sector is read out or disabled
+	if ((cd_drive_irq & io.cd_port_1802 & 0x40)
+		&& !(io.irq_mask & IRQ2)) {
+		io.irq_status |= IRQ2;
+		return INT_IRQ2;
+	}
+
+	return INT_NONE;
+}
+
+
+void
+pce_cd_drive_dma(void)
+{
+	cd_drive_dma = 1;
+	cd_drive_irq &= ~0x40;
+}
+
+
+void
+pce_cd_drive_stop(void)
+{
+	pce_cd_drive_busy = 0;
+	cd_drive_waiting = 0;
+	cd_drive_dma = 0;
+	cd_drive_irq = 0;
+	io.irq_status &= ~IRQ2;
+}
+
+
+/*
+ * High level CD_READ. The system card polls the drive and moves each byte
+ * of the data port itself, for the length of the seek and the 75 sectors
+ * per second of the drive. Here the call copies the sectors once, then
+ * leaves the drive idle at the last one read.
+ */
+
+//! Zero page registers of the system card calls
+#define CD_BIOS_AX 0xF8
+#define CD_BIOS_AL 0xF8
+#define CD_BIOS_BX 0xFA
+#define CD_BIOS_BL 0xFA
+#define CD_BIOS_CL 0xFC
+#define CD_BIOS_CH 0xFD
+#define CD_BIOS_DL 0xFE
+#define CD_BIOS_DH 0xFF
+
+//! Copy length bytes to the logical address offset, a page at a time.
+//! Pages mapped on the hardware go through the write handlers.
+static void
+pce_cd_bios_read_local(uint16 offset, uint32 length)
+{
+	while (length) {
+		uint32 sector_length = MIN(length, (uint32) 2048);
+		uchar *data;
+
+		pce_cd_read_sector();
+		data = cd_read_buffer;
+		length -= sector_length;
+
+		while (sector_length) {
+			uint16 page = offset >> 13;
+			uint32 chunk = MIN(sector_length,
+							   (uint32) (0x2000 - (offset & 0x1FFF)));
+
+			if (PageW[page] == IOAREA) {
+				uint32 index;
+
+				for (index = 0; index < chunk; index++)
+					IO_write((uint16) (offset + index), data[index]);
+			} else
+				memcpy(PageW[page] + offset, data, chunk);
+
+			offset += chunk;
+			data += chunk;
+			sector_length -= chunk;
+		}
+	}
+}
+
+
+//! Copy length bytes to the 8KB banks from bank on
+static void
+pce_cd_bios_read_banks(uchar bank, uint32 length)
+{
+	uint32 bank_offset = 0;
+
+	while (length) {
+		uint32 sector_length = MIN(length, (uint32) 2048);
+
+		pce_cd_read_sector();
+		length -= sector_length;
+
+		if (ROMMapW[bank] != IOAREA)
+			memcpy(ROMMapW[bank] + bank_offset, cd_read_buffer,
+				   sector_length);
+		bank_offset += 2048;
+		if (bank_offset == 0x2000) {
+			bank_offset = 0;
+			bank++;
+		}
+	}
+}
+
+
+//! Write length bytes to VRAM from MAWR on, as the VDC data port would
+static void
+pce_cd_bios_read_vram(uint32 length)
+{
+	while (length) {
+		uint32 sector_length = MIN(length, (uint32) 2048);
+		uint32 index;
+
+		pce_cd_read_sector();
+		length -= sector_length;
+
+		for (index = 0; index < sector_length; index += 2) {
+			uint16 address = IO_VDC_00_MAWR.W & 0x7FFF;
+
+			VRAM[address * 2] = cd_read_buffer[index];
+			VRAM[address * 2 + 1] = cd_read_buffer[index + 1];
+
+			// Only the patterns and sprites written are converted again
+			vchange[address / 16] = 1;
+			vchanges[address / 64] = 1;
+
+			IO_VDC_00_MAWR.W += io.vdc_inc;
+		}
+
+		io.vdc_ratch = cd_read_buffer[index - 2];
+	}
+}
+
+
+int
+pce_cd_bios_read(void)
+{
+	uchar mode = get_8bit_zp_(CD_BIOS_DH);
+	uchar sectors = get_8bit_zp_(CD_BIOS_AL);
+	uint16 offset = get_16bit_zp_(CD_BIOS_BX);
+	uint16 base = 0x2274 + 3 * Rd6502(0x2273);
+	uchar status = 0;
+
+	// The call only lands in the system card with a disc and bank 0 at $E000
+	if (option.want_cd_read_lle || !CD_emulation || mmr[7] != 0x00)
+		return 0;
+
+	if (mode > 6 && mode < 0xFE)
+		return 0;
+
+	// Sector relative to the base set by CD_BASE
+	pce_cd_sectoraddy = (get_8bit_zp_(CD_BIOS_CL) << 16)
+		+ (get_8bit_zp_(CD_BIOS_CH) << 8) + get_8bit_zp_(CD_BIOS_DL)
+		+ (Rd6502(base) << 16) + (Rd6502(base + 1) << 8) + Rd6502(base + 2);
+
+#if ENABLE_TRACING_CD
+	TRACE("CDRom2: CD_READ mode 0x%02X of sector %d at once\n", mode,
+		  pce_cd_sectoraddy);
+#endif
+
+	switch (mode) {
+	case 0:
+		// Bytes to the logical address bx
+		pce_cd_bios_read_local(offset, get_16bit_zp_(CD_BIOS_AX));
+		break;
+
+	case 1:
+		// Sectors to the logical address bx
+		pce_cd_bios_read_local(offset, sectors * 2048);
+		break;
+
+	case 0xFE:
+	case 0xFF:
+		// Bytes or sectors to the VRAM address bx
+		if (mode == 0xFF && !sectors) {
+			status = 0x22;
+			break;
+		}
+
+		IO_write(0, 0);
+		IO_write(2, (uchar) (offset & 0xFF));
+		IO_write(3, (uchar) (offset >> 8));
+		IO_write(0, 2);
+
+		pce_cd_bios_read_vram(mode == 0xFF ? sectors * 2048
+							  : get_16bit_zp_(CD_BIOS_AX));
+		break;
+
+	default:
+		// Sectors to the banks from bl on, through MPR dh
+		pce_cd_bios_read_banks(get_8bit_zp_(CD_BIOS_BL), sectors * 2048);
+		break;
+	}
+
+	// Over, with the bus free and the head after the last sector
+	pce_cd_drive_stop();
+	cd_drive_head = pce_cd_sectoraddy;
+	cd_sectorcnt = 0;
+	cd_read_buffer = NULL;
+	pce_cd_read_datacnt = 0;
+	pce_cd_curcmd = 0;
+	io.cd_port_1800 = 0;
+
+	reg_p = (reg_p & ~(FL_N | FL_T | FL_Z)) | flnz_list[reg_a = status];
+	return 1;
+}
+
+
 static void
 pce_cd_handle_command(void)
 {
@@ -86,7 +440,7 @@ pce_cd_handle_command(void)
 				}
 
 				pce_cd_set_sector_address();
-				pce_cd_read_sector();
+				pce_cd_drive_seek();
 
 
 				/* TEST */
@@ -132,6 +486,8 @@ pce_cd_handle_command(void)
 					 pce_cd_temp_stop[0] | pce_cd_temp_stop[1]) == 0) {
 					if (CD_emulation == 5)
 						HCD_play_track(bcdbin[pce_cd_temp_play[2]], 1);
+					else if (CD_emulation >= 2 && CD_emulation <= 4)
+						cdda_play_track(bcdbin[pce_cd_temp_play[2]], 1);
 					else
 						osd_cd_play_audio_track(bcdbin
 												[pce_cd_temp_play[2]]);
@@ -148,6 +504,18 @@ pce_cd_handle_command(void)
 													bcdbin[pce_cd_temp_stop
 														   [0]]),
 										 pce_cd_temp_stop[3] == 1);
+					} else if (CD_emulation >= 2 && CD_emulation <= 4) {
+						cdda_play_sectors(Time2HSG
+										  (bcdbin[pce_cd_temp_play[2]],
+										   bcdbin[pce_cd_temp_play[1]],
+										   bcdbin[pce_cd_temp_play[0]]),
+										  Time2HSG(bcdbin
+												   [pce_cd_temp_stop[2]],
+												   bcdbin[pce_cd_temp_stop
+														  [1]],
+												   bcdbin[pce_cd_temp_stop
+														  [0]]),
+										  pce_cd_temp_stop[3] == 1);
 					} else {
 						osd_cd_play_audio_range(bcdbin
 												[pce_cd_temp_play[2]],
@@ -358,6 +726,8 @@ pce_cd_handle_command(void)
 				osd_cd_stop_audio();
 			else if (CD_emulation == 5)
 				HCD_pause_playing();
+			else if (CD_emulation >= 2 && CD_emulation <= 4)
+				cdda_pause();
 			break;
 		case 0xDE:
 			/* Get CD directory info */
@@ -384,6 +754,14 @@ pce_cd_handle_read_1800(uint16 A)
 		{
 			uchar retval;
 
+			if (cd_drive_waiting) {
+				// Read before the request, don't hand out garbage
+#if ENABLE_TRACING_CD
+				TRACE("CDRom2: Data read while the drive is seeking\n");
+#endif
+				pce_cd_drive_deliver();
+			}
+
 			if (cd_read_buffer) {
 				retval = *cd_read_buffer++;
 				if (pce_cd_read_datacnt == 2048) {
@@ -413,7 +791,7 @@ pce_cd_handle_read_1800(uint16 A)
 
 			/* TEST */// return 0x20;
 
-			return tmp_res | 0x20;
+			return tmp_res | 0x20 | cd_drive_irq;
 		}
 
 		/* TEST */
@@ -441,14 +819,25 @@ pce_cd_handle_read_1800(uint16 A)
 			return NODATA;
 		}
 
-	case 0x0B:					/* TEST */
-		return 0x00;
-	case 0x0C:					/* TEST */
-		return 0x01;			// 0x89
-	case 0x0D:					/* TEST */
-		return 0x00;
+	case 0x0B:
+		// $180B - ADPCM DMA control, the request bits stay up while the
+		// sectors are moved
+		return cd_drive_dma ? cd_port_180b & 0x03 : 0x00;
+	case 0x0C:
+		// $180C - ADPCM status: playing, else over, and busy while the
+		// DMA writes the ADPCM RAM
+		return (io.adpcm_psize ? 0x08 : 0x01) | (cd_drive_dma ? 0x04 : 0x00);
+	case 0x0D:
+		return cd_port_180d;
 
 	case 8:
+		if (cd_drive_waiting) {
+#if ENABLE_TRACING_CD
+			TRACE("CDRom2: Data read while the drive is seeking\n");
+#endif
+			pce_cd_drive_deliver();
+		}
+
 		if (pce_cd_read_datacnt) {
 			uchar retval;
 
@@ -465,13 +854,14 @@ pce_cd_handle_read_1800(uint16 A)
 #endif
 					io.cd_port_1800 |= 0x10;
 					pce_cd_curcmd = 0;
+					pce_cd_drive_stop();
 				} else {
 #if ENABLE_TRACING_CD
 					// not really needed unless troubleshooting sector reading
 					TRACE("CDRom2: Sector data left count: %d\n",
 						  cd_sectorcnt);
 #endif
-					pce_cd_read_sector();
+					pce_cd_drive_next();
 				}
 			}
 			return retval;
@@ -572,7 +962,9 @@ pce_cd_handle_write_1800(uint16 A, uchar V)
 			}
 
 			if (io.cd_port_1800 & 0x08) {
-				if (io.cd_port_1800 & 0x20) {
+				if (cd_drive_waiting || cd_drive_dma) {
+					// Nothing to acknowledge, the sector isn't on the port
+				} else if (io.cd_port_1800 & 0x20) {
 					io.cd_port_1800 &= ~0x80;
 				} else if (!pce_cd_read_datacnt) {
 					if (pce_cd_curcmd == 0x08) {
@@ -582,12 +974,13 @@ pce_cd_handle_write_1800(uint16 A, uchar V)
 #endif
 							io.cd_port_1800 |= 0x10;	/* wrong */
 							pce_cd_curcmd = 0x00;
+							pce_cd_drive_stop();
 						} else {
 #if ENABLE_TRACING_CD
 							TRACE("CDRom2: Sector data count: %d\n",
 								  cd_sectorcnt);
 #endif
-							pce_cd_read_sector();
+							pce_cd_drive_next();
 						}
 					} else {
 						if (io.cd_port_1800 & 0x10) {
@@ -617,6 +1010,8 @@ pce_cd_handle_write_1800(uint16 A, uchar V)
 			TRACE("CDRom2: Reset mode for CD asked\n");
 #endif
 
+			pce_cd_drive_stop();
+
 			switch (CD_emulation) {
 			case 1:
 				if (osd_cd_init(ISO_filename) != 0) {
@@ -730,7 +1125,15 @@ pce_cd_handle_write_1800(uint16 A, uchar V)
 		/* TEST */
 		// if (V & 0x08) io.
 
+		if (V & 0x10) {
+			cd_adpcm_length = io.adpcm_ptr.W;	// set length
+#if ENABLE_TRACING_CD
+			TRACE("CDRom2: Set ADPCM length to 0x%X\n", cd_adpcm_length);
+#endif
+		}
+
 		if (V & 0x80) {
+			io.adpcm_psize = 0;
 #if ENABLE_TRACING_CD
 			TRACE("CDRom2: Reset mode for ADPCM\n");
 #endif
@@ -739,13 +1142,26 @@ pce_cd_handle_write_1800(uint16 A, uchar V)
 			TRACE("CDRom2: Normal mode for ADPCM\n");
 #endif
 		}
+
+		// Play bit, what AD_PLAY of the bios ends up writing
+		if ((V & 0x40) && !(cd_port_180d & 0x40) && !(V & 0x80)) {
+			io.adpcm_pptr = io.adpcm_rptr << 1;
+			io.adpcm_psize = cd_adpcm_length << 1;
+			new_adpcm_play = 1;
+#if ENABLE_TRACING_CD
+			TRACE("CDRom2: Play ADPCM from 0x%X\n", io.adpcm_rptr);
+#endif
+		} else if (!(V & 0x40) && (cd_port_180d & 0x40))
+			io.adpcm_psize = 0;
+
+		cd_port_180d = V;
 		return;
 
 	case 0xe:
 		// $180E - ADPCM playback rate
-		io.adpcm_rate = 32 / (16 - (V & 15));	// Set ADPCM playback rate
+		io.adpcm_rate = 16 - (V & 15);	// Set ADPCM playback rate
 #if ENABLE_TRACING_CD
-		TRACE("CDRom2: ADPCM rate set to %d kHz\n", io.adpcm_rate);
+		TRACE("CDRom2: ADPCM rate set to %d Hz\n", 32000 / io.adpcm_rate);
 #endif
 		return;
 
@@ -30,4 +30,38 @@
 uchar pce_cd_handle_read_1800(uint16 A);
 void pce_cd_handle_write_1800(uint16 A, uchar V);
 
+/*
+ * Drive timing, counted in scanlines (263 lines at 60 frames per second).
+ * A single speed drive streams a sector every 1/75s, any seek first moves
+ * the sled, for a fixed cost plus a cost growing with the distance.
+ */
+#define CD_DRIVE_SECTOR_LINES 210
+#define CD_DRIVE_SEEK_LINES (263 * 3)
+#define CD_DRIVE_SEEK_SECTORS_PER_LINE 32
+
+//! Set while a READ command is in progress, pce_cd_drive_tick must then
+//! be called once per scanline
+extern uchar pce_cd_drive_busy;
+
+//! Advance the drive by one scanline, returns INT_IRQ2 or INT_NONE
+uchar pce_cd_drive_tick(void);
+
+//! Bytes moved to the ADPCM RAM per scanline, faster than the drive
+#define CD_DRIVE_DMA_BYTES 16
+
+//! Send the sectors left in the READ command to the ADPCM RAM, at
+//! io.adpcm_dmaptr, as the drive delivers them
+void pce_cd_drive_dma(void);
+
+//! Abort the READ command in progress
+void pce_cd_drive_stop(void);
+
+//! CD_READ entry of the system card jump table
+#define CD_BIOS_READ 0xE009
+
+//! Run a CD_READ call of the system card at once, the sectors copied in
+//! bulk from the sector cache. Returns 0 when the system card code has to
+//! run instead, else the registers are set as the call returns them.
+int pce_cd_bios_read(void);
+
 #endif
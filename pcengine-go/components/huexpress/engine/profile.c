@@ -0,0 +1,184 @@
+/***************************************************************************/
+/*                                                                         */
+/*                          CPU profiler Source File                       */
+/*                                                                         */
+/*     Histogram of the (bank, PC) pairs sampled by the cpu loop, and its  */
+/*     dump with the disassembly of the hottest instructions.              */
+/*                                                                         */
+/***************************************************************************/
+
+#include "pce.h"
+
+#ifdef MY_PROFILE_PC
+
+#include <string.h>
+
+#include "defs.h"
+#include "format.h"
+
+extern operation optable_runtime[256];
+
+//! Size and formatter of each addressing mode, in the AM_ order of
+//! dis_runtime.h. optable.c has them too, but MY_EXCLUDE leaves it out.
+static const mode_struct profile_modes[] = {
+	{1, implicit}, {2, immed}, {2, relative}, {2, ind_zp}, {2, ind_zpx},
+	{2, ind_zpy}, {2, ind_zpind}, {2, ind_zpix}, {2, ind_zpiy}, {3, absol},
+	{3, absx}, {3, absy}, {3, absind}, {3, absindx}, {3, pseudorel},
+	{3, tst_zp}, {4, tst_abs}, {3, tst_zpx}, {4, tst_absx}, {7, xfer}
+};
+
+typedef struct {
+	//! bank << 16 | PC
+	uint32 key;
+	//! 0 for a free slot
+	uint32 count;
+} profile_slot;
+
+PCE_LOCAL uint32 profile_countdown = PROFILE_SCANLINES;
+
+static PCE_LOCAL profile_slot *profile_slots = NULL;
+static PCE_LOCAL uint32 profile_banks[256];
+static PCE_LOCAL uint32 profile_samples;
+//! Samples of new PCs found no free slot
+static PCE_LOCAL uint32 profile_dropped;
+
+
+void
+profile_add(uchar bank, uint16 pc)
+{
+	uint32 key = (bank << 16) | pc;
+	uint32 index = (key * 2654435761u) >> 16;
+	int probe;
+
+	if (!profile_slots) {
+		profile_slots = (profile_slot *) my_special_alloc(false, 4,
+			PROFILE_SLOTS * sizeof(profile_slot));
+		memset(profile_slots, 0, PROFILE_SLOTS * sizeof(profile_slot));
+	}
+
+	profile_samples++;
+	profile_banks[bank]++;
+
+	for (probe = 0; probe < PROFILE_PROBES; probe++) {
+		profile_slot *slot = &profile_slots[(index + probe) & (PROFILE_SLOTS - 1)];
+
+		if (slot->count && slot->key != key)
+			continue;
+
+		slot->key = key;
+		slot->count++;
+		return;
+	}
+
+	profile_dropped++;
+}
+
+
+static int
+profile_compare(const void *a, const void *b)
+{
+	uint32 count_a = ((const profile_slot *) a)->count;
+	uint32 count_b = ((const profile_slot *) b)->count;
+
+	return count_a < count_b ? 1 : count_a > count_b ? -1 : 0;
+}
+
+
+//! Byte of the bank at offset, which may be past its end
+static uchar
+profile_read(uchar bank, uint32 offset)
+{
+	bank += offset >> 13;
+	return ROMMapR[bank] ? ROMMapR[bank][offset & 0x1FFF] : 0xFF;
+}
+
+
+static void
+profile_disassemble(char *line, uchar bank, uint16 pc)
+{
+	uint32 offset = pc & 0x1FFF;
+	const operation *op = &optable_runtime[profile_read(bank, offset)];
+	const mode_struct *mode = &profile_modes[op->addr_mode];
+	uchar opbuf[7];
+	int i;
+
+	for (i = 0; i < mode->size; i++)
+		opbuf[i] = profile_read(bank, offset + i);
+
+	(*mode->func_format) (line, pc, opbuf, (char *) op->opname);
+}
+
+
+void
+profile_dump(void)
+{
+	char path[PATH_MAX];
+	char line[256];
+	uchar bank_order[256];
+	uint32 index, count, used = 0;
+	FILE *f;
+
+	if (!profile_slots)
+		return;
+
+	snprintf(path, PATH_MAX, "%s/profile.txt", config_basepath);
+	if (!(f = fopen(path, "w"))) {
+		MESSAGE_ERROR("Couldn't create %s\n", path);
+		f = stdout;
+	}
+
+	fprintf(f, "# %u samples, %u dropped\n", profile_samples,
+		profile_dropped);
+
+	// Banks, busiest first
+	for (index = 0; index < 256; index++)
+		bank_order[index] = index;
+	for (index = 1; index < 256; index++)
+		for (count = index; count > 0
+			&& profile_banks[bank_order[count]]
+			> profile_banks[bank_order[count - 1]]; count--) {
+			uchar swap = bank_order[count];
+			bank_order[count] = bank_order[count - 1];
+			bank_order[count - 1] = swap;
+		}
+
+	fprintf(f, "# bank  samples\n");
+	for (index = 0; index < 256; index++) {
+		uchar bank = bank_order[index];
+
+		if (!profile_banks[bank])
+			break;
+		fprintf(f, "  %02X  %8u  %5.2f%%\n", bank, profile_banks[bank],
+			100.0 * profile_banks[bank] / profile_samples);
+	}
+
+	// The slots are sorted in place, the histogram is started again anyway
+	for (index = 0; index < PROFILE_SLOTS; index++)
+		if (profile_slots[index].count)
+			profile_slots[used++] = profile_slots[index];
+	qsort(profile_slots, used, sizeof(profile_slot), profile_compare);
+
+	fprintf(f, "# bank:pc  samples\n");
+	for (index = 0; index < used && index < PROFILE_TOP; index++) {
+		uchar bank = profile_slots[index].key >> 16;
+		uint16 pc = profile_slots[index].key;
+
+		profile_disassemble(line, bank, pc);
+		fprintf(f, "  %02X:%04X  %8u  %5.2f%%  %s\n", bank, pc,
+			profile_slots[index].count,
+			100.0 * profile_slots[index].count / profile_samples, line);
+	}
+
+	if (f != stdout) {
+		fclose(f);
+		MESSAGE_INFO("Profile of %u samples written to %s\n",
+			profile_samples, path);
+	}
+
+	free(profile_slots);
+	profile_slots = NULL;
+	memset(profile_banks, 0, sizeof(profile_banks));
+	profile_samples = profile_dropped = 0;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+#include "cleantypes.h"
+
+/*
+ * Sampling profiler of the emulated CPU. At the end of some scanlines the
+ * cpu loop records the bank mapped at the PC (mmr) together with the PC in
+ * a fixed size hash histogram, so the memory used doesn't depend on the
+ * game. profile_dump() writes the sample count of each bank and the top
+ * hotspots, disassembled, to profile.txt in the config directory.
+ */
+
+#ifdef MY_PROFILE_PC
+
+//! Slots of the histogram, a power of two
+#define PROFILE_SLOTS 4096
+
+//! Slots tried for a new PC before its sample is dropped
+#define PROFILE_PROBES 16
+
+//! Scanlines (455 cycles) between two samples
+#define PROFILE_SCANLINES 1
+
+//! Hotspots written by profile_dump
+#define PROFILE_TOP 64
+
+extern PCE_LOCAL uint32 profile_countdown;
+
+//! Count one sample of PC in bank
+void profile_add(uchar bank, uint16 pc);
+
+//! Write the histogram and start a new one
+void profile_dump(void);
+
+#define profile_sample() { \
+    if (!--profile_countdown) { \
+        profile_countdown = PROFILE_SCANLINES; \
+        profile_add(mmr[reg_pc >> 13], reg_pc); \
+    } \
+    }
+
+#else
+
+#define profile_sample()
+#define profile_dump()
+
+#endif
+
+#endif
@@ -0,0 +1,503 @@
+/***************************************************************************/
+/*                                                                         */
+/*                        Rollback netplay Source File                     */
+/*                                                                         */
+/*     Runs ahead of the other peer on predicted inputs, snapshots the     */
+/*     console every frame and replays it from the first wrong guess.      */
+/*     See rollback.h.                                                     */
+/*                                                                         */
+/***************************************************************************/
+
+#include "pce.h"
+
+#ifdef MY_NETPLAY_ROLLBACK
+
+#include <string.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "pce_instance.h"
+
+/*
+ * Packet, numbers are little endian:
+ *   "HR", pad of the sender, CRC of the rom,
+ *   remote inputs the sender received, frame of the first input carried,
+ *   number of inputs, frame and CRC of the last RAM check, then the inputs.
+ */
+#define ROLLBACK_PACKET_PLAYER 2
+#define ROLLBACK_PACKET_ROM_CRC 3
+#define ROLLBACK_PACKET_ACK 7
+#define ROLLBACK_PACKET_FIRST 11
+#define ROLLBACK_PACKET_COUNT 15
+#define ROLLBACK_PACKET_CHECK_FRAME 16
+#define ROLLBACK_PACKET_CHECK_CRC 20
+#define ROLLBACK_PACKET_INPUTS 24
+#define ROLLBACK_PACKET_SIZE (ROLLBACK_PACKET_INPUTS + ROLLBACK_INPUTS)
+
+//! Longest wait for the other peer between two resends, in seconds
+#define ROLLBACK_RESEND_DELAY (1.0 / 60)
+
+//! Time given to the other peer to receive the last inputs when stopping
+#define ROLLBACK_FLUSH_DELAY 1.0
+
+struct rollback_snapshot {
+	uint32 frame;
+	uint32 timer_phase;
+	pce_instance instance;
+	struct_hard_pce hard;
+	uchar *PageR[8];
+	uchar *PageW[8];
+	pair VCE[0x200];
+	uchar psg_da_data[6][PSG_DIRECT_ACCESS_BUFSIZE];
+	uchar RAM[0x8000];
+	uchar WRAM[0x2000];
+	uchar VRAM[VRAMSIZE];
+	uint16 SPRAM[64 * 4];
+	uchar Pal[512];
+};
+
+PCE_LOCAL pce_rollback rollback = { .socket = -1 };
+
+
+static double
+rollback_time(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+
+static void
+rollback_write32(uchar * data, uint32 value)
+{
+	data[0] = value;
+	data[1] = value >> 8;
+	data[2] = value >> 16;
+	data[3] = value >> 24;
+}
+
+
+static uint32
+rollback_read32(uchar * data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32) data[3] << 24);
+}
+
+
+static void
+rollback_save(uint32 index, uint32 timer_phase)
+{
+	rollback_snapshot *snapshot = &rollback.snapshots[index % ROLLBACK_FRAMES];
+	int channel;
+
+	snapshot->frame = index;
+	snapshot->timer_phase = timer_phase;
+	pce_instance_store(&snapshot->instance);
+	snapshot->hard = *hard_pce;
+	memcpy(snapshot->PageR, PageR, sizeof(snapshot->PageR));
+	memcpy(snapshot->PageW, PageW, sizeof(snapshot->PageW));
+	memcpy(snapshot->VCE, io.VCE, sizeof(snapshot->VCE));
+	for (channel = 0; channel < 6; channel++)
+		memcpy(snapshot->psg_da_data[channel], io.psg_da_data[channel],
+			PSG_DIRECT_ACCESS_BUFSIZE);
+	memcpy(snapshot->RAM, RAM, sizeof(snapshot->RAM));
+	memcpy(snapshot->WRAM, WRAM, sizeof(snapshot->WRAM));
+	memcpy(snapshot->VRAM, VRAM, sizeof(snapshot->VRAM));
+	memcpy(snapshot->SPRAM, SPRAM, sizeof(snapshot->SPRAM));
+	memcpy(snapshot->Pal, Pal, sizeof(snapshot->Pal));
+}
+
+
+//! \return the timer phase saved with the snapshot
+static uint32
+rollback_restore(uint32 index)
+{
+	rollback_snapshot *snapshot = &rollback.snapshots[index % ROLLBACK_FRAMES];
+	pce_movie playing = movie;
+	int frames_drawn = frame;
+	int frames_to_skip = UCount;
+	int channel;
+
+	pce_instance_restore(&snapshot->instance);
+	// The movie feeding the local pad and the display aren't rolled back
+	movie = playing;
+	frame = frames_drawn;
+	UCount = frames_to_skip;
+
+	// The memory blocks are the same, only their content is copied back
+	*hard_pce = snapshot->hard;
+	memcpy(PageR, snapshot->PageR, sizeof(snapshot->PageR));
+	memcpy(PageW, snapshot->PageW, sizeof(snapshot->PageW));
+	memcpy(io.VCE, snapshot->VCE, sizeof(snapshot->VCE));
+	for (channel = 0; channel < 6; channel++)
+		memcpy(io.psg_da_data[channel], snapshot->psg_da_data[channel],
+			PSG_DIRECT_ACCESS_BUFSIZE);
+	memcpy(RAM, snapshot->RAM, sizeof(snapshot->RAM));
+	memcpy(WRAM, snapshot->WRAM, sizeof(snapshot->WRAM));
+	memcpy(VRAM, snapshot->VRAM, sizeof(snapshot->VRAM));
+	memcpy(SPRAM, snapshot->SPRAM, sizeof(snapshot->SPRAM));
+	memcpy(Pal, snapshot->Pal, sizeof(snapshot->Pal));
+
+	// The linear tiles and sprites were made from the newer VRAM
+	memset(vchange, 1, VRAMSIZE / 32);
+	memset(vchanges, 1, VRAMSIZE / 128);
+
+	return snapshot->timer_phase;
+}
+
+
+static void
+rollback_send(void)
+{
+	uchar packet[ROLLBACK_PACKET_SIZE] = { 'H', 'R', rollback.player };
+	uint32 first = rollback.remote_ack;
+	uint32 count = rollback.local_count - first;
+	uint32 index;
+
+	if (count > ROLLBACK_INPUTS) {
+		first = rollback.local_count - ROLLBACK_INPUTS;
+		count = ROLLBACK_INPUTS;
+	}
+
+	rollback_write32(packet + ROLLBACK_PACKET_ROM_CRC, ROM_CRC);
+	rollback_write32(packet + ROLLBACK_PACKET_ACK, rollback.remote_count);
+	rollback_write32(packet + ROLLBACK_PACKET_FIRST, first);
+	packet[ROLLBACK_PACKET_COUNT] = count;
+	rollback_write32(packet + ROLLBACK_PACKET_CHECK_FRAME, rollback.check_frame);
+	rollback_write32(packet + ROLLBACK_PACKET_CHECK_CRC, rollback.check_crc);
+	for (index = 0; index < count; index++)
+		packet[ROLLBACK_PACKET_INPUTS + index] =
+			rollback.local_inputs[(first + index) & (ROLLBACK_INPUTS - 1)];
+
+	// A full socket buffer only loses a packet the next one repeats
+	sendto(rollback.socket, packet, ROLLBACK_PACKET_INPUTS + count, 0,
+		(struct sockaddr *) rollback.remote_address,
+		sizeof(struct sockaddr_in));
+}
+
+
+static void
+rollback_compare_checks(void)
+{
+	if (!rollback.check_frame
+		|| rollback.check_frame != rollback.remote_check_frame
+		|| rollback.check_frame == rollback.compared_frame)
+		return;
+
+	rollback.checks++;
+	if (rollback.check_crc != rollback.remote_check_crc) {
+		rollback.desyncs++;
+		MESSAGE_ERROR("Netplay desync at frame %u, RAM CRC %08X, other peer "
+			"%08X\n", rollback.check_frame, rollback.check_crc,
+			rollback.remote_check_crc);
+	}
+	rollback.compared_frame = rollback.check_frame;
+}
+
+
+static void
+rollback_receive(void)
+{
+	uchar packet[ROLLBACK_PACKET_SIZE];
+	uint32 first, count, index;
+	uchar input;
+	int size;
+
+	while ((size = recv(rollback.socket, packet, sizeof(packet), 0)) > 0) {
+		if (size < ROLLBACK_PACKET_INPUTS || packet[0] != 'H'
+			|| packet[1] != 'R')
+			continue;
+
+		if (packet[ROLLBACK_PACKET_PLAYER] == rollback.player
+			|| rollback_read32(packet + ROLLBACK_PACKET_ROM_CRC) != ROM_CRC) {
+			MESSAGE_ERROR("Netplay packet from player %d with rom CRC=%08X "
+				"ignored\n", packet[ROLLBACK_PACKET_PLAYER] + 1,
+				rollback_read32(packet + ROLLBACK_PACKET_ROM_CRC));
+			continue;
+		}
+
+		rollback.last_receive_time = rollback_time();
+
+		index = rollback_read32(packet + ROLLBACK_PACKET_ACK);
+		if (index > rollback.remote_ack && index <= rollback.local_count)
+			rollback.remote_ack = index;
+
+		index = rollback_read32(packet + ROLLBACK_PACKET_CHECK_FRAME);
+		if (index > rollback.remote_check_frame) {
+			rollback.remote_check_frame = index;
+			rollback.remote_check_crc =
+				rollback_read32(packet + ROLLBACK_PACKET_CHECK_CRC);
+			rollback_compare_checks();
+		}
+
+		first = rollback_read32(packet + ROLLBACK_PACKET_FIRST);
+		count = packet[ROLLBACK_PACKET_COUNT];
+		if (ROLLBACK_PACKET_INPUTS + count > size)
+			continue;
+
+		// Packets may come twice or out of order, only the next inputs count
+		for (index = rollback.remote_count - first; index < count
+			&& first <= rollback.remote_count; index++) {
+			input = packet[ROLLBACK_PACKET_INPUTS + index];
+			rollback.remote_inputs[rollback.remote_count
+				& (ROLLBACK_INPUTS - 1)] = input;
+
+			if (rollback.remote_count < rollback.frame
+				&& rollback.predicted_inputs[rollback.remote_count
+					& (ROLLBACK_INPUTS - 1)] != input
+				&& rollback.mispredicted == ROLLBACK_NONE)
+				rollback.mispredicted = rollback.remote_count;
+
+			rollback.remote_count++;
+		}
+	}
+}
+
+
+//! Wait until the other peer is close enough for its inputs to be rolled back
+static void
+rollback_wait(void)
+{
+	struct timeval timeout;
+	fd_set sockets;
+
+	// The other peer may be ahead as well
+	while ((int32) (rollback.frame - rollback.remote_count) >= ROLLBACK_FRAMES) {
+		if (rollback_time() - rollback.last_receive_time > ROLLBACK_TIMEOUT) {
+			MESSAGE_ERROR("No news from the other peer for %ds, netplay "
+				"stopped\n", ROLLBACK_TIMEOUT);
+			rollback_stop();
+			return;
+		}
+
+		rollback.stalls++;
+		rollback_send();
+
+		FD_ZERO(&sockets);
+		FD_SET(rollback.socket, &sockets);
+		timeout.tv_sec = 0;
+		timeout.tv_usec = ROLLBACK_RESEND_DELAY * 1e6;
+		select(rollback.socket + 1, &sockets, NULL, NULL, &timeout);
+
+		rollback_receive();
+	}
+}
+
+
+//! Set the pads of both players for frame index
+static void
+rollback_set_inputs(uint32 index)
+{
+	uchar remote;
+
+	if (index < rollback.remote_count)
+		remote = rollback.remote_inputs[index & (ROLLBACK_INPUTS - 1)];
+	else {
+		// The other player is guessed to keep the last state received
+		remote = rollback.remote_inputs[(rollback.remote_count - 1)
+			& (ROLLBACK_INPUTS - 1)];
+		rollback.predicted_inputs[index & (ROLLBACK_INPUTS - 1)] = remote;
+	}
+
+	memset(io.JOY, 0, MOVIE_PADS);
+	io.JOY[rollback.player] =
+		rollback.local_inputs[index & (ROLLBACK_INPUTS - 1)];
+	io.JOY[!rollback.player] = remote;
+}
+
+
+//! CRC the RAM of the latest snapshot whose inputs are all known
+static void
+rollback_check(void)
+{
+	rollback_snapshot *snapshot;
+
+	while (rollback.next_check < rollback.frame
+		&& rollback.next_check <= rollback.remote_count) {
+		snapshot = &rollback.snapshots[rollback.next_check % ROLLBACK_FRAMES];
+
+		if (snapshot->frame == rollback.next_check) {
+			rollback.check_frame = rollback.next_check;
+			rollback.check_crc = CRC_buffer(snapshot->RAM, 0x2000);
+			rollback_compare_checks();
+		}
+		rollback.next_check += ROLLBACK_CHECK_FRAMES;
+	}
+}
+
+
+int
+rollback_start(int player, int local_port, const char *remote, int delay)
+{
+	struct addrinfo hints = { 0 }, *address;
+	struct sockaddr_in local = { 0 };
+	char host[256];
+	char *port;
+	uint32 index;
+
+	rollback_stop();
+
+	if (CD_emulation) {
+		MESSAGE_ERROR("Netplay only runs HuCards\n");
+		return 1;
+	}
+
+	if (player < 0 || player > 1 || delay < 0
+		|| delay >= ROLLBACK_INPUTS - 2 * ROLLBACK_FRAMES) {
+		MESSAGE_ERROR("Netplay player %d, input delay %d out of range\n",
+			player + 1, delay);
+		return 1;
+	}
+
+	strncpy(host, remote, sizeof(host) - 1);
+	host[sizeof(host) - 1] = 0;
+	if (!(port = strrchr(host, ':'))) {
+		MESSAGE_ERROR("Netplay peer %s isn't host:port\n", remote);
+		return 1;
+	}
+	*port++ = 0;
+
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	if (getaddrinfo(host, port, &hints, &address)) {
+		MESSAGE_ERROR("Couldn't resolve %s\n", remote);
+		return 1;
+	}
+	memcpy(rollback.remote_address, address->ai_addr,
+		sizeof(struct sockaddr_in));
+	freeaddrinfo(address);
+
+	local.sin_family = AF_INET;
+	local.sin_port = htons(local_port);
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	if ((rollback.socket = socket(AF_INET, SOCK_DGRAM, 0)) < 0
+		|| bind(rollback.socket, (struct sockaddr *) &local, sizeof(local))) {
+		MESSAGE_ERROR("Couldn't listen to UDP port %d\n", local_port);
+		if (rollback.socket >= 0)
+			close(rollback.socket);
+		rollback.socket = -1;
+		return 1;
+	}
+	fcntl(rollback.socket, F_SETFL,
+		fcntl(rollback.socket, F_GETFL, 0) | O_NONBLOCK);
+
+	rollback.player = player;
+	rollback.delay = delay;
+	rollback.frame = 0;
+	rollback.resimulate_end = 0;
+	rollback.mispredicted = ROLLBACK_NONE;
+	// Both pads are released for the frames before the first input
+	memset(rollback.local_inputs, 0, ROLLBACK_INPUTS);
+	memset(rollback.remote_inputs, 0, ROLLBACK_INPUTS);
+	rollback.local_count = rollback.remote_count = rollback.remote_ack = delay;
+	rollback.check_frame = rollback.remote_check_frame = 0;
+	rollback.compared_frame = 0;
+	rollback.next_check = ROLLBACK_CHECK_FRAMES;
+	rollback.last_receive_time = rollback_time();
+	rollback.rollbacks = rollback.resimulated = rollback.longest_rollback = 0;
+	rollback.stalls = rollback.checks = rollback.desyncs = 0;
+
+	rollback.snapshots = (rollback_snapshot *) my_special_alloc(false, 4,
+		ROLLBACK_FRAMES * sizeof(rollback_snapshot));
+	for (index = 0; index < ROLLBACK_FRAMES; index++)
+		rollback.snapshots[index].frame = ROLLBACK_NONE;
+
+	MESSAGE_INFO("Netplay as player %d with %s, %d frames of input delay, "
+		"%u KB of snapshots\n", player + 1, remote, delay,
+		(uint32) (ROLLBACK_FRAMES * sizeof(rollback_snapshot) / 1024));
+	return 0;
+}
+
+
+void
+rollback_stop(void)
+{
+	double start = rollback_time();
+
+	if (rollback.socket < 0)
+		return;
+
+	// The other peer may still need the last inputs
+	while (rollback.remote_ack < rollback.local_count
+		&& rollback_time() - start < ROLLBACK_FLUSH_DELAY) {
+		rollback_send();
+		usleep(ROLLBACK_RESEND_DELAY * 1e6);
+		rollback_receive();
+	}
+
+	MESSAGE_INFO("Netplay: %u frames, %u rollbacks (%u frames run again, "
+		"longest %u), %u stalls, %u checks, %u desyncs\n", rollback.frame,
+		rollback.rollbacks, rollback.resimulated, rollback.longest_rollback,
+		rollback.stalls, rollback.checks, rollback.desyncs);
+
+	close(rollback.socket);
+	rollback.socket = -1;
+	free(rollback.snapshots);
+	rollback.snapshots = NULL;
+	rollback.resimulate_end = 0;
+}
+
+
+int
+rollback_frame(uint32 *timer_phase)
+{
+	uint32 index = rollback.frame;
+	uint32 depth;
+
+	if (!rollback.snapshots)
+		return 0;
+
+	if (rollback.resimulate_end) {
+		rollback.resimulated++;
+		rollback_save(index, *timer_phase);
+		rollback_set_inputs(index);
+		rollback.frame++;
+
+		// Back to the frame the rollback started from, its input is known
+		if (index == rollback.resimulate_end) {
+			rollback.resimulate_end = 0;
+			rollback_check();
+		}
+		return 0;
+	}
+
+	rollback.local_inputs[(index + rollback.delay) & (ROLLBACK_INPUTS - 1)] =
+		io.JOY[0];
+	rollback.local_count = index + rollback.delay + 1;
+
+	rollback_send();
+	rollback_receive();
+	rollback_wait();
+	if (!rollback.snapshots)
+		return 0;
+
+	if (rollback.mispredicted != ROLLBACK_NONE) {
+		depth = index - rollback.mispredicted;
+		rollback.rollbacks++;
+		if (depth > rollback.longest_rollback)
+			rollback.longest_rollback = depth;
+
+		// This frame is set up again once the older ones ran
+		rollback.resimulate_end = index;
+		index = rollback.mispredicted;
+		rollback.mispredicted = ROLLBACK_NONE;
+		*timer_phase = rollback_restore(index);
+		rollback_set_inputs(index);
+		rollback.frame = index + 1;
+		return 1;
+	}
+
+	rollback_save(index, *timer_phase);
+	rollback_set_inputs(index);
+	rollback.frame++;
+	rollback_check();
+	return 0;
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef _ROLLBACK_H_
+#define _ROLLBACK_H_
+
+#include "cleantypes.h"
+
+/*
+ * Rollback netplay between two consoles. Each peer runs its own frames
+ * without waiting: the input of the other player is predicted (it keeps its
+ * last known state), and a snapshot of the console is kept for each of the
+ * last ROLLBACK_FRAMES frames. When an input arrives that differs from its
+ * prediction, the console goes back to the snapshot of that frame and runs
+ * again up to the current one, without display nor vsync wait.
+ *
+ * The inputs are exchanged over UDP. Each packet carries every local input
+ * the other peer didn't acknowledge yet, so lost packets need no resend, and
+ * from time to time the CRC of the RAM of a frame whose inputs are all
+ * known, to catch desyncs.
+ *
+ * rollback_frame() is called once per frame, right after osd_keyboard() and
+ * movie_frame() set the local pad in io.JOY[0]. Snapshots are taken there,
+ * so a restored console resumes at the same point of Loop6502; the timer
+ * phase, local to exe_go, is passed along with them.
+ */
+
+#ifdef MY_NETPLAY_ROLLBACK
+
+#if !defined(MY_INLINE_GFX_Loop6502) || !defined(MY_h6280_exe_go) \
+	|| defined(MY_h6280_ON_CPU0)
+#error "MY_NETPLAY_ROLLBACK needs the timer phase of exe_go, see MY_INLINE_GFX_Loop6502"
+#endif
+
+//! Snapshots kept, also the most frames a peer runs ahead of the other
+#define ROLLBACK_FRAMES 8
+
+//! Inputs kept for each player, a power of two above twice ROLLBACK_FRAMES
+#define ROLLBACK_INPUTS 64
+
+//! Frames between two RAM CRC exchanged to check the peers are in sync
+#define ROLLBACK_CHECK_FRAMES 60
+
+//! Seconds without a packet before the other peer is given up
+#define ROLLBACK_TIMEOUT 10
+
+#define ROLLBACK_DEFAULT_PORT 25680
+
+//! No misprediction waiting for a rollback
+#define ROLLBACK_NONE 0xFFFFFFFF
+
+typedef struct rollback_snapshot rollback_snapshot;
+
+typedef struct {
+	int socket;
+	//! struct sockaddr_in of the other peer
+	uchar remote_address[16];
+	//! Pad of the local player, the other one gets the other pad
+	uchar player;
+	//! Frames between reading a local input and running it
+	uchar delay;
+
+	//! Frame set up by the next call to rollback_frame, counted from the
+	//! start of the session
+	uint32 frame;
+	//! Frame the console resimulates up to, 0 when not rolling back
+	uint32 resimulate_end;
+	//! Local inputs known, they are for frames [0, local_count[
+	uint32 local_count;
+	//! Remote inputs received
+	uint32 remote_count;
+	//! Local inputs the other peer received
+	uint32 remote_ack;
+	uchar local_inputs[ROLLBACK_INPUTS];
+	uchar remote_inputs[ROLLBACK_INPUTS];
+	//! Remote inputs used for the frames run before they were received
+	uchar predicted_inputs[ROLLBACK_INPUTS];
+	//! Earliest frame run with a wrong prediction, ROLLBACK_NONE if none
+	uint32 mispredicted;
+
+	rollback_snapshot *snapshots;
+
+	//! Last RAM CRC of each peer, for the frame given, 0 if none yet
+	uint32 check_frame, check_crc;
+	uint32 remote_check_frame, remote_check_crc;
+	//! Last frame whose CRC were compared
+	uint32 compared_frame;
+	uint32 next_check;
+
+	double last_receive_time;
+
+	uint32 rollbacks;
+	uint32 resimulated;
+	uint32 longest_rollback;
+	uint32 stalls;
+	uint32 checks;
+	uint32 desyncs;
+} pce_rollback;
+
+extern PCE_LOCAL pce_rollback rollback;
+
+//! Start a session as player 0 or 1 from the next frame, call it after
+//! ResetPCE. remote is "host:port", the other peer or a relay
+//! \return 0 on success
+int rollback_start(int player, int local_port, const char *remote, int delay);
+
+//! Send the last inputs, print the statistics and close the session
+void rollback_stop(void);
+
+//! Take the local input, exchange the inputs and set io.JOY for this frame.
+//! timer_phase is saved with the snapshot and restored with it
+//! \return 1 if the console was rolled back to an older frame
+int rollback_frame(uint32 *timer_phase);
+
+#define rollback_active() (rollback.snapshots != NULL)
+
+//! Resimulating: skip the display, the vsync wait and the local input
+#define rollback_silent() (rollback.resimulate_end != 0)
+
+#else
+
+#define rollback_stop()
+#define rollback_active() 0
+#define rollback_silent() 0
+
+#endif
+
+#endif
@@ -25,23 +25,33 @@
 #define JAP          0x8000
 
 // Known Rom Count (from kKnownRoms)
-//#define KNOWN_ROM_COUNT 428
-#define KNOWN_ROM_COUNT 1
+#define KNOWN_ROM_COUNT 428
 
 struct rom_database {
 	uint32      CRC;
-	char		Name[255];
-	char		Publisher[64];
-	char		ID[64];
-	char		Date[16];
+	const char *Name;
+	const char *Publisher;
+	const char *ID;
+	const char *Date;
 	uint32      Flags;
+	//! Banks 0-31 of the rom read the most, worth a copy in fast memory
+	uint32      HotBanks;
+	//! System card byte of bank 0xE1 to patch, if not 0
+	uint16      PatchOffset;
+	uchar       PatchValue;
 };
 
-extern struct rom_database kKnownRoms[KNOWN_ROM_COUNT];
+extern const struct rom_database kKnownRoms[KNOWN_ROM_COUNT];
 
 
 unsigned long filesize(FILE * F);
 uint32 CRC_file(char *name);
+//! Same CRC as CRC_file, for bytes already in memory
+uint32 CRC_buffer(uchar * data, uint32 size);
+//! CRC of the bytes given after the ones whose CRC is CRC, 0 to start
+uint32 CRC_update(uint32 CRC, const uchar * data, uint32 size);
+//! Index in kKnownRoms of the rom of this CRC, -1 if unknown
+int romdb_find(uint32 CRC);
 
 
 #endif /* _ROMDB_H */
@@ -104,7 +104,7 @@ typedef struct tagIO {
 	pair adpcm_ptr;
 	uint16 adpcm_rptr, adpcm_wptr;
 	uint16 adpcm_dmaptr;
-	uchar adpcm_rate;
+	uchar adpcm_rate;			/* playback rate divider, 32000 / adpcm_rate Hz, 0 if unset */
 	uint32 adpcm_pptr;			/* to know where to begin playing adpcm (in nibbles) */
 	uint32 adpcm_psize;			/* to know how many 4-bit samples to play */
 
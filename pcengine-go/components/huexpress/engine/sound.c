@@ -10,6 +10,48 @@
 
 #include "sound.h"
 
+#include <string.h>
+#include <time.h>
+
+
+static void
+put_le32(uchar * p, uint32 value)
+{
+	p[0] = value;
+	p[1] = value >> 8;
+	p[2] = value >> 16;
+	p[3] = value >> 24;
+}
+
+
+/* Write the 0x2C bytes RIFF header of a PCM wav holding data_length bytes */
+void
+write_wav_header(FILE * file, uint32 freq, int channels, int bits,
+				 uint32 data_length)
+{
+	uchar header[WAV_HEADER_SIZE];
+
+	memcpy(header, "RIFF", 4);
+	put_le32(header + 4, data_length + WAV_HEADER_SIZE - 8);
+	memcpy(header + 8, "WAVEfmt ", 8);
+	put_le32(header + 16, 16);	// fmt chunk size
+	header[20] = 1;				// PCM data
+	header[21] = 0;
+	header[22] = channels;
+	header[23] = 0;
+	put_le32(header + 24, freq);
+	put_le32(header + 28, freq * channels * bits / 8);	// bytes per second
+	header[32] = channels * bits / 8;	// bytes per frame
+	header[33] = 0;
+	header[34] = bits;
+	header[35] = 0;
+	memcpy(header + 36, "data", 4);
+	put_le32(header + 40, data_length);
+
+	fseek(file, 0, SEEK_SET);
+	fwrite(header, WAV_HEADER_SIZE, 1, file);
+}
+
 #if 0
 
 #include <SDL_audio.h>
@@ -216,6 +258,7 @@ write_adpcm(void)
 
 	static char index;
 	static int32 previousValue;
+	static uint32 phase;
 
 	if (CycleNew != CycleOld) {
 		Cycle = CycleNew - CycleOld;
@@ -231,6 +274,7 @@ write_adpcm(void)
 	if (new_adpcm_play) {
 		index = 0;
 		previousValue = 0;
+		phase = 0;
 	}
 
 	if (AdpcmFilledBuf > io.adpcm_psize)
@@ -238,7 +282,7 @@ write_adpcm(void)
 
 	AdpcmUsedNibbles
 		= WriteBufferAdpcm8(adpcmbuf, io.adpcm_pptr, AdpcmFilledBuf,
-							&index, &previousValue);
+							AdpcmFilledBuf, &index, &previousValue, &phase);
 
 	io.adpcm_pptr += AdpcmUsedNibbles;
 	io.adpcm_pptr &= 0x1FFFF;
@@ -289,85 +333,43 @@ start_dump_audio(void)
 			 tm_current_time->tm_min, tm_current_time->tm_sec);
 
 	audio_output_file = fopen(audio_output_filename, "wb");
+	if (audio_output_file == NULL)
+		return 0;
 
 	sound_dump_length = 0;
 
-	fwrite("RIFF\145\330\073\0WAVEfmt ", 16, 1, audio_output_file);
-	putc(0x10, audio_output_file);	// size
-	putc(0x00, audio_output_file);
-	putc(0x00, audio_output_file);
-	putc(0x00, audio_output_file);
-	putc(1, audio_output_file);	// PCM data
-	putc(0, audio_output_file);
-
-	if (host.sound.stereo)
-		putc(2, audio_output_file);	// stereo
-	else
-		putc(1, audio_output_file);	// mono
-
-	putc(0, audio_output_file);
-
-	putc(host.sound.freq, audio_output_file);	// frequency
-	putc(host.sound.freq >> 8, audio_output_file);
-	putc(host.sound.freq >> 16, audio_output_file);
-	putc(host.sound.freq >> 24, audio_output_file);
-
-	if (host.sound.stereo) {
-		putc(host.sound.freq << 1, audio_output_file);	// size of data per second
-		putc(host.sound.freq >> 7, audio_output_file);
-		putc(host.sound.freq >> 15, audio_output_file);
-		putc(host.sound.freq >> 23, audio_output_file);
-	} else {
-		putc(host.sound.freq, audio_output_file);	// size of data per second
-		putc(host.sound.freq >> 8, audio_output_file);
-		putc(host.sound.freq >> 16, audio_output_file);
-		putc(host.sound.freq >> 24, audio_output_file);
-	}
-
-	if (host.sound.stereo)
-		putc(2, audio_output_file);	// byte per sample
-	else
-		putc(1, audio_output_file);
-	putc(0, audio_output_file);
-
-	putc(8, audio_output_file);	// 8 bits
-	putc(0, audio_output_file);
-
-	fwrite("data\377\377\377\377", 1, 9, audio_output_file);
+	// Sizes are filled when stopping
+	write_wav_header(audio_output_file, host.sound.freq,
+					 host.sound.stereo ? 2 : 1, 8, 0);
 	osd_gfx_set_message("Audio dumping on");
 
-	return (audio_output_file != NULL ? 1 : 0);
+	return 1;
 }
 
 
 void
 stop_dump_audio(void)
 {
-	uint32 dum;
-
 	if (audio_output_file == NULL)
 		return;
 
-	dum = sound_dump_length + 0x2C;	// Total file size, header is 0x2C long
-	fseek(audio_output_file, 4, SEEK_SET);
-	putc(dum, audio_output_file);
-	putc(dum >> 8, audio_output_file);
-	putc(dum >> 16, audio_output_file);
-	putc(dum >> 24, audio_output_file);
-
-	dum = sound_dump_length;	// Audio stream size
-	fseek(audio_output_file, 0x28, SEEK_SET);
-	putc(dum, audio_output_file);
-	putc(dum >> 8, audio_output_file);
-	putc(dum >> 16, audio_output_file);
-	putc(dum >> 24, audio_output_file);
+	write_wav_header(audio_output_file, host.sound.freq,
+					 host.sound.stereo ? 2 : 1, 8, sound_dump_length);
 
 	fclose(audio_output_file);
+	audio_output_file = NULL;
 
 	osd_gfx_set_message("Audio dumping off");
 }
 
 
+int
+dump_audio_running(void)
+{
+	return audio_output_file != NULL;
+}
+
+
 void
 dump_audio_chunck(uchar * content, int length)
 {
@@ -399,6 +401,7 @@ dump_audio_chunck(uchar * content, int length)
 }
 #else
 
+#include "mix.h"
 
 uchar gen_vol = 255;
 int BaseClock = 7170000;
@@ -406,8 +409,260 @@ int BaseClock = 7170000;
 //uint32 CycleNew;
 uchar new_adpcm_play = 0;
 uint32 AdpcmFilledBuf = 0;
+char *adpcmbuf;
+
+
+/* Decode dwSize bytes of adpcm into adpcmbuf, called once per audio block */
+void
+write_adpcm_block(unsigned dwSize)
+{
+	uint32 AdpcmUsedNibbles;
+
+	static char index;
+	static int32 previousValue;
+	static uint32 phase;
+
+	if (new_adpcm_play) {
+		index = 0;
+		previousValue = 0;
+		phase = 0;
+		new_adpcm_play = 0;
+	}
+
+	AdpcmUsedNibbles
+		= WriteBufferAdpcm8(adpcmbuf, io.adpcm_pptr, io.adpcm_psize,
+							dwSize, &index, &previousValue, &phase);
+
+	io.adpcm_pptr += AdpcmUsedNibbles;
+	io.adpcm_pptr &= 0x1FFFF;
+
+	if (AdpcmUsedNibbles < io.adpcm_psize)
+		io.adpcm_psize -= AdpcmUsedNibbles;
+	else
+		io.adpcm_psize = 0;
+
+	// Used by AD_STAT to know if the sample is still playing
+	AdpcmFilledBuf = AdpcmUsedNibbles;
+}
+
+
+/*
+ * Audio dump. The audio task only copies the mixed blocks into a ring, a
+ * low priority task writes it to the SD card so the card latency never
+ * reaches the audio output. Host builds write from the caller instead.
+ */
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#endif
+
+//! Bytes buffered between the audio task and the writer, about 6 sec
+#define DUMP_RING_SIZE (512 * 1024)
+
+//! The writer only issues writes of this size, aligned in the file
+#define DUMP_WRITE_SIZE (32 * 1024)
+
+typedef enum {
+	DUMP_REQUEST_WAKE,
+	DUMP_REQUEST_STOP
+} dump_request_type;
+
+#ifdef ESP_PLATFORM
+static QueueHandle_t dump_queue = NULL;
+static TaskHandle_t dump_task_handle;
+#endif
+
+static uchar *dump_ring = NULL;
+static volatile uint32 dump_write = 0;	/* owned by the audio task */
+static volatile uint32 dump_read = 0;	/* owned by the writer task */
+static volatile uchar dump_running = 0;
+
+//! Bytes dropped because the writer couldn't keep up
+static uint32 dump_overruns;
+
+static FILE *audio_output_file = NULL;
+static uint32 sound_dump_length;
+
+
+//! Write count bytes of the ring to the dump file
+static void
+dump_flush(uint32 count)
+{
+	uint32 index, length;
+
+	while (count) {
+		index = dump_read % DUMP_RING_SIZE;
+		length = MIN(count, DUMP_RING_SIZE - index);
+
+		fwrite(dump_ring + index, length, 1, audio_output_file);
+
+		dump_read += length;
+		sound_dump_length += length;
+		count -= length;
+	}
+}
+
+
+static void
+dump_handle(dump_request_type request)
+{
+	uint32 offset, length;
+
+	if (!audio_output_file)
+		return;
+
+	/*
+	 * The header takes the start of the first block so every write
+	 * after it begins on a DUMP_WRITE_SIZE boundary of the file
+	 */
+	offset = (WAV_HEADER_SIZE + sound_dump_length) % DUMP_WRITE_SIZE;
+	length = DUMP_WRITE_SIZE - offset;
+
+	while (dump_write - dump_read >= length) {
+		dump_flush(length);
+		length = DUMP_WRITE_SIZE;
+	}
+
+	if (request == DUMP_REQUEST_STOP) {
+		dump_flush(dump_write - dump_read);
+
+		write_wav_header(audio_output_file, host.sound.freq, 2, 16,
+						 sound_dump_length);
+		fclose(audio_output_file);
+		audio_output_file = NULL;
+
+		MESSAGE_INFO("Audio dump: %d bytes written, %d dropped\n",
+					 sound_dump_length, dump_overruns);
+	}
+}
+
+
+#ifdef ESP_PLATFORM
+static void
+dump_task(void *arg)
+{
+	dump_request_type request;
+
+	while (1) {
+		if (xQueueReceive(dump_queue, &request, portMAX_DELAY) == pdTRUE)
+			dump_handle(request);
+	}
+}
+#endif
+
+
+//! Hand a request to the writer, wait for room in its queue if asked to
+static void
+dump_send(dump_request_type request, int wait)
+{
+#ifdef ESP_PLATFORM
+	xQueueSend(dump_queue, &request, wait ? portMAX_DELAY : 0);
+#else
+	dump_handle(request);
+#endif
+}
+
+
+//! Start the audio dump process
+//! return 1 if audio dumping began, else 0
+int
+start_dump_audio(void)
+{
+	char audio_output_filename[PATH_MAX];
+	struct tm *tm_current_time;
+	time_t time_t_current_time;
+
+	if (dump_running || audio_output_file != NULL)
+		return 0;
+
+	if (!dump_ring) {
+		dump_ring = (uchar *) my_special_alloc(false, 4, DUMP_RING_SIZE);
+#ifdef ESP_PLATFORM
+		dump_queue = xQueueCreate(8, sizeof(dump_request_type));
+		xTaskCreatePinnedToCore(&dump_task, "dumpTask", 1024 * 3, NULL, 2,
+								&dump_task_handle, 1);
+#endif
+	}
+
+	time(&time_t_current_time);
+	tm_current_time = localtime(&time_t_current_time);
+
+	snprintf(audio_output_filename, PATH_MAX,
+			 "%s/audio-%04d-%02d-%02d %02d-%02d-%02d.wav", config_basepath,
+			 tm_current_time->tm_year + 1900, tm_current_time->tm_mon + 1,
+			 tm_current_time->tm_mday, tm_current_time->tm_hour,
+			 tm_current_time->tm_min, tm_current_time->tm_sec);
+
+	audio_output_file = fopen(audio_output_filename, "wb");
+	if (audio_output_file == NULL) {
+		MESSAGE_ERROR("Couldn't create %s\n", audio_output_filename);
+		return 0;
+	}
+
+	// Blocks are already sized for the card, skip the stdio copy
+	setvbuf(audio_output_file, NULL, _IONBF, 0);
+
+	// Sizes are filled when stopping
+	write_wav_header(audio_output_file, host.sound.freq, 2, 16, 0);
+
+	sound_dump_length = 0;
+	dump_overruns = 0;
+	dump_read = dump_write = 0;
+	dump_running = 1;
+
+	MESSAGE_INFO("Audio dumping to %s\n", audio_output_filename);
+	return 1;
+}
+
+
+void
+stop_dump_audio(void)
+{
+	if (!dump_running)
+		return;
+
+	dump_running = 0;
+	dump_send(DUMP_REQUEST_STOP, 1);
+}
 
 
+int
+dump_audio_running(void)
+{
+	return dump_running;
+}
+
+
+//! Queue a mixed block of 16 bit stereo samples, never blocks
+void
+dump_audio_chunck(uchar * content, int length)
+{
+	uint32 index, count;
+
+	if (!dump_running)
+		return;
+
+	if (DUMP_RING_SIZE - (dump_write - dump_read) < (uint32) length) {
+		dump_overruns += length;
+		return;
+	}
+
+	while (length) {
+		index = dump_write % DUMP_RING_SIZE;
+		count = MIN((uint32) length, DUMP_RING_SIZE - index);
+
+		memcpy(dump_ring + index, content, count);
+
+		dump_write += count;
+		content += count;
+		length -= count;
+	}
+
+	dump_send(DUMP_REQUEST_WAKE, 0);
+}
+
 
 
 
@@ -56,10 +56,17 @@ void write_psg(int ch);
 void WriteBuffer(char *, int, unsigned);
 
 void write_adpcm(void);
+void write_adpcm_block(unsigned dwSize);
 void dump_audio_chunck(uchar * content, int length);
 
 int start_dump_audio(void);
 void stop_dump_audio(void);
+int dump_audio_running(void);
+
+#define WAV_HEADER_SIZE 0x2C
+
+void write_wav_header(FILE * file, uint32 freq, int channels, int bits,
+					  uint32 data_length);
 
 
 #endif							// HDEF_SOUND_H
@@ -38,21 +38,21 @@ uchar BGONSwitch = 1;
 uchar SPONSwitch = 1;
 // Do we have to draw sprites ?
 
-uint32 *spr_init_pos;//[1024];
+PCE_LOCAL uint32 *spr_init_pos;//[1024];
 // cooked initial position of sprite
 
 void (*RefreshSprite) (int Y1, int Y2, uchar bg);
 
-int ScrollYDiff;
-int oldScrollX;
-int oldScrollY;
-int oldScrollYDiff;
+PCE_LOCAL int ScrollYDiff;
+PCE_LOCAL int oldScrollX;
+PCE_LOCAL int oldScrollY;
+PCE_LOCAL int oldScrollYDiff;
 
 // Actual memory area where the gfx functions are drawing sprites and tiles
-uchar *SPM_raw;//[XBUF_WIDTH * XBUF_HEIGHT];
-/*static*/ uchar *SPM;// = SPM_raw + XBUF_WIDTH * 64 + 32;
+PCE_LOCAL uchar *SPM_raw;//[XBUF_WIDTH * XBUF_HEIGHT];
+/*static*/ PCE_LOCAL uchar *SPM;// = SPM_raw + XBUF_WIDTH * 64 + 32;
 
-int frame = 0;
+PCE_LOCAL int frame = 0;
 // number of frame displayed
 
 #ifndef MY_INLINE_SPRITE_CheckSprites
@@ -469,6 +469,6 @@ RefreshSpriteExact(int Y1, int Y2, uchar bg)
 char tmp_str[10];
 extern int vheight;
 extern char *sbuf[];
-int sprite_usespbg = 0;
+PCE_LOCAL int sprite_usespbg = 0;
 
 
@@ -51,22 +51,22 @@ extern uchar SPONSwitch;
 #define	ScrollX	IO_VDC_07_BXR.W
 #define	ScrollY	IO_VDC_08_BYR.W
 
-extern int ScrollYDiff;
+extern PCE_LOCAL int ScrollYDiff;
 
-extern int oldScrollX;
-extern int oldScrollY;
-extern int oldScrollYDiff;
+extern PCE_LOCAL int oldScrollX;
+extern PCE_LOCAL int oldScrollY;
+extern PCE_LOCAL int oldScrollYDiff;
 
-extern uint32 *spr_init_pos;//[1024];
+extern PCE_LOCAL uint32 *spr_init_pos;//[1024];
 // cooked initial position of sprite
 
 extern char exact_putspritem;
 // do we use a slow but precise function to draw certain sprites
 
-extern int frame;
+extern PCE_LOCAL int frame;
 // number of frame displayed
 
-extern int sprite_usespbg;
+extern PCE_LOCAL int sprite_usespbg;
 
 //extern void (*PutSpriteMaskedFunction)(byte *P,byte *C,unsigned   long *C2,byte *R,int h,int inc,byte *M,byte pr);
 // the general function for *masked
@@ -90,7 +90,8 @@ extern void (*RefreshSprite) (int Y1, int Y2, uchar bg);
 #define FC_H     256
 #define V_FLIP  0x8000
 #define H_FLIP  0x0800
-extern uchar *SPM;
+extern PCE_LOCAL uchar *SPM;
+extern PCE_LOCAL uchar *SPM_raw;
 
 #ifdef MY_INLINE_SPRITE
 #include "sprite_ops_define.h"
@@ -20,7 +20,7 @@
    * XBuf->line[0] since it's the first byte of the REAL data in this bitmap.
    * Its size must be OSD_GFX_WIDTH * OSD_GFX_HEIGHT
    */
-extern uchar *osd_gfx_buffer;
+extern PCE_LOCAL uchar *osd_gfx_buffer;
 
    /*
     * osd_gfx_driver
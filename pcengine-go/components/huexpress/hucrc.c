@@ -5,20 +5,25 @@
 int
 main(int argc, char* argv[])
 {
-	char* filename = argv[1];
-	uint32 CRC = CRC_file(filename);
-	int32 romindex = -1;
-
 	int index;
-	for (index = 0; index < KNOWN_ROM_COUNT; index++) {
-		if (CRC == kKnownRoms[index].CRC)
-			romindex = index;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s rom...\n", argv[0]);
+		return 2;
 	}
 
-	if (romindex == -1)
-		printf("%s; CRC=%lx; Unknown\n", filename, CRC);
-	else
-		printf("%s; CRC=%lx; %s\n", filename, CRC, kKnownRoms[romindex].Name);
+	// Same CRC and lookup as ResetPCE, one line per rom
+	for (index = 1; index < argc; index++) {
+		char* filename = argv[index];
+		uint32 CRC = CRC_file(filename);
+		int romindex = romdb_find(CRC);
+
+		if (romindex == -1)
+			printf("%s; CRC=%lx; Unknown\n", filename, (unsigned long) CRC);
+		else
+			printf("%s; CRC=%lx; %s\n", filename, (unsigned long) CRC,
+				kKnownRoms[romindex].Name);
+	}
 
 	return 0;
 }
@@ -0,0 +1,520 @@
+/***************************************************************************/
+/*                                                                         */
+/*                        Regression runner Source File                    */
+/*                                                                         */
+/*     Runs every rom of a directory headless, one console per thread,     */
+/*     and checks the CRC of the screen and of the RAM every few frames    */
+/*     against golden files. Built with PCE_THREADED_INSTANCES.            */
+/*                                                                         */
+/*     huregress [-j jobs] [-f frames] [-n interval] [-u] [-t trace]       */
+/*               roms golden                                               */
+/*                                                                         */
+/*     The input of rom.pce is played from the movie rom.hmv if present.   */
+/*     The golden file of rom.pce is golden/rom.crc, one                   */
+/*     "frame screen_crc ram_crc" line per check. -u writes them.          */
+/*                                                                         */
+/***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include "pce.h"
+#include "utils.h"
+
+#if !defined(PCE_THREADED_INSTANCES)
+#error "huregress must be built with PCE_THREADED_INSTANCES"
+#endif
+
+extern char *rom_file_name;
+extern char *syscard_filename;
+
+typedef struct {
+	uint32 frame;
+	uint32 screen_crc;
+	uint32 ram_crc;
+} regress_check;
+
+typedef struct {
+	char name[NAME_MAX + 1];
+
+	//! Checks read from, or to be written to, the golden file
+	regress_check *checks;
+	uint32 check_count;
+
+	uint32 frame;
+	//! First frame whose CRCs differ from the golden file, 0 if none
+	uint32 divergent_frame;
+	const char *divergent_part;
+	const char *error;
+	double seconds;
+} regress_run;
+
+static const char *rom_dir;
+static const char *golden_dir;
+static uint32 frames = 3600;
+static uint32 interval = 60;
+static int update = 0;
+static const char *trace_path = NULL;
+
+static regress_run *runs;
+static int run_count;
+static int next_run = 0;
+
+//! CartLoad and InitPCE fill process wide names and paths
+static pthread_mutex_t load_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//! Rom being run by this thread
+static PCE_LOCAL regress_run *current;
+
+PCE_LOCAL uchar *osd_gfx_buffer = NULL;
+
+bool skipNextFrame = false;
+
+
+static double
+regress_time(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+
+static void
+regress_frame_done(void)
+{
+	regress_run *run = current;
+	uint32 screen_crc = 0;
+	uint32 line;
+	regress_check *check;
+
+	run->frame++;
+	if (run->frame % interval)
+		return;
+
+	for (line = 0; line < io.screen_h; line++)
+		screen_crc = CRC_update(screen_crc,
+			osd_gfx_buffer + line * XBUF_WIDTH, io.screen_w);
+
+	if (update) {
+		check = &run->checks[run->check_count++];
+		check->frame = run->frame;
+		check->screen_crc = screen_crc;
+		check->ram_crc = CRC_buffer(RAM, 0x2000);
+		return;
+	}
+
+	for (check = run->checks; check < run->checks + run->check_count; check++)
+		if (check->frame == run->frame)
+			break;
+
+	if (check == run->checks + run->check_count)
+		return;
+
+	if (check->screen_crc != screen_crc)
+		run->divergent_part = "screen";
+	else if (check->ram_crc != CRC_buffer(RAM, 0x2000))
+		run->divergent_part = "RAM";
+	else
+		return;
+
+	run->divergent_frame = run->frame;
+}
+
+
+static int
+regress_gfx_init(void)
+{
+	return 0;
+}
+
+
+static int
+regress_gfx_mode(void)
+{
+	return 0;
+}
+
+
+static void
+regress_gfx_shut(void)
+{
+}
+
+
+osd_gfx_driver osd_gfx_driver_list[3] = {
+	{regress_gfx_init, regress_gfx_mode, regress_frame_done, regress_gfx_shut},
+	{regress_gfx_init, regress_gfx_mode, regress_frame_done, regress_gfx_shut},
+	{regress_gfx_init, regress_gfx_mode, regress_frame_done, regress_gfx_shut}
+};
+
+
+int
+osd_keyboard(void)
+{
+	regress_run *run = current;
+
+	if (run->frame >= frames || run->divergent_frame)
+		return 1;
+
+	// Pads are released once the movie is over
+	memset(io.JOY, 0, MOVIE_PADS);
+
+	return 0;
+}
+
+
+void
+osd_gfx_set_color(uchar index, uchar r, uchar g, uchar b)
+{
+}
+
+
+void
+osd_gfx_set_message(char *message)
+{
+}
+
+
+char
+osd_keypressed(void)
+{
+	return 0;
+}
+
+
+uint16
+osd_readkey(void)
+{
+	return 0;
+}
+
+
+void *
+my_special_alloc_try(unsigned char speed, unsigned char bytes, unsigned long size)
+{
+	return calloc(1, size);
+}
+
+
+void *
+my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long size)
+{
+	void *rc = calloc(1, size);
+
+	if (!rc)
+		abort();
+	return rc;
+}
+
+
+unsigned long
+my_special_free_largest(unsigned char speed)
+{
+	return ULONG_MAX;
+}
+
+
+bool
+my_special_release_framebuffer(void)
+{
+	return false;
+}
+
+
+void
+dump_heap_info_short(void)
+{
+}
+
+
+static void
+regress_play_movie(regress_run *run)
+{
+	char path[PATH_MAX];
+	char *dot;
+
+	snprintf(path, sizeof(path), "%s/%s", rom_dir, run->name);
+	if ((dot = strrchr(path, '.')))
+		strcpy(dot, ".hmv");
+
+	if (access(path, R_OK))
+		return;
+
+	if (movie_play(path, 0))
+		run->error = "can't play the movie";
+}
+
+
+static void
+regress_golden_path(regress_run *run, char *path)
+{
+	char *dot;
+
+	snprintf(path, PATH_MAX, "%s/%s", golden_dir, run->name);
+	if ((dot = strrchr(path, '.')))
+		strcpy(dot, ".crc");
+}
+
+
+static void
+regress_load_golden(regress_run *run)
+{
+	char path[PATH_MAX];
+	regress_check check;
+	FILE *f;
+
+	run->checks = calloc(frames / interval + 1, sizeof(regress_check));
+	if (update)
+		return;
+
+	regress_golden_path(run, path);
+	if (!(f = fopen(path, "r"))) {
+		run->error = "no golden file";
+		return;
+	}
+
+	while (run->check_count <= frames / interval
+		&& fscanf(f, "%u %x %x", &check.frame, &check.screen_crc,
+			&check.ram_crc) == 3)
+		run->checks[run->check_count++] = check;
+	fclose(f);
+}
+
+
+static void
+regress_save_golden(regress_run *run)
+{
+	char path[PATH_MAX];
+	uint32 index;
+	FILE *f;
+
+	regress_golden_path(run, path);
+	if (!(f = fopen(path, "w"))) {
+		run->error = "can't write the golden file";
+		return;
+	}
+
+	for (index = 0; index < run->check_count; index++)
+		fprintf(f, "%u %08X %08X\n", run->checks[index].frame,
+			run->checks[index].screen_crc, run->checks[index].ram_crc);
+	fclose(f);
+}
+
+
+static void
+regress_run_rom(regress_run *run)
+{
+	char path[PATH_MAX];
+	uchar *xbuf;
+	double start;
+
+	regress_load_golden(run);
+	if (run->error)
+		return;
+
+	// Per console buffers the device allocates in app_main
+	xbuf = calloc(1, XBUF_WIDTH * XBUF_HEIGHT);
+	SPM_raw = calloc(1, XBUF_WIDTH * XBUF_HEIGHT);
+	spr_init_pos = calloc(1024, sizeof(uint32));
+	osd_gfx_buffer = xbuf + 32 + 64 * XBUF_WIDTH;
+	SPM = SPM_raw + XBUF_WIDTH * 64 + 32;
+
+	current = run;
+	snprintf(path, sizeof(path), "%s/%s", rom_dir, run->name);
+
+	pthread_mutex_lock(&load_lock);
+	if (InitPCE(path))
+		run->error = "can't load the rom";
+	else if (ResetPCE()) {
+		run->error = "can't reset the console";
+		TrashPCE();
+	}
+	pthread_mutex_unlock(&load_lock);
+
+	if (!run->error) {
+		regress_play_movie(run);
+		if (!run->error) {
+			start = regress_time();
+			exe_go();
+			run->seconds = regress_time() - start;
+			movie_stop();
+		}
+
+		pthread_mutex_lock(&load_lock);
+		TrashPCE();
+		pthread_mutex_unlock(&load_lock);
+	}
+
+	if (update && !run->error)
+		regress_save_golden(run);
+
+	free(spr_init_pos);
+	free(SPM_raw);
+	free(xbuf);
+}
+
+
+static void *
+regress_thread(void *arg)
+{
+	regress_run *run;
+
+	while (1) {
+		pthread_mutex_lock(&load_lock);
+		run = next_run < run_count ? &runs[next_run++] : NULL;
+		pthread_mutex_unlock(&load_lock);
+
+		if (!run)
+			return NULL;
+
+		regress_run_rom(run);
+	}
+}
+
+
+static int
+regress_list_roms(void)
+{
+	DIR *dir;
+	struct dirent *entry;
+	char *dot;
+
+	if (!(dir = opendir(rom_dir)))
+		return 1;
+
+	while ((entry = readdir(dir))) {
+		dot = strrchr(entry->d_name, '.');
+		if (!dot || (strcasecmp(dot, ".pce") && strcasecmp(dot, ".sgx")))
+			continue;
+
+		runs = realloc(runs, (run_count + 1) * sizeof(regress_run));
+		memset(&runs[run_count], 0, sizeof(regress_run));
+		strncpy(runs[run_count].name, entry->d_name, NAME_MAX);
+		run_count++;
+	}
+	closedir(dir);
+
+	return 0;
+}
+
+
+static void
+regress_init_paths(void)
+{
+	static char config_dir[] = "/tmp/huregressXXXXXX";
+	char **paths[] = { &cart_name, &short_cart_name, &short_iso_name,
+		&rom_file_name, &config_basepath, &sav_path, &sav_basepath,
+		&tmp_basepath, &video_path, &ISO_filename, &syscard_filename,
+		&log_filename
+	};
+	int index;
+
+	for (index = 0; index < sizeof(paths) / sizeof(paths[0]); index++)
+		*paths[index] = calloc(1, PATH_MAX);
+
+	// TrashPCE saves the backup ram there
+	if (mkdtemp(config_dir))
+		strcpy(config_basepath, config_dir);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	pthread_t *threads;
+	uint32 total_frames = 0;
+	int failures = 0;
+	double start, seconds;
+	int option_char, index;
+
+	while ((option_char = getopt(argc, argv, "j:f:n:ut:")) != -1) {
+		switch (option_char) {
+		case 'j':
+			jobs = atoi(optarg);
+			break;
+		case 'f':
+			frames = atoi(optarg);
+			break;
+		case 'n':
+			interval = atoi(optarg);
+			break;
+		case 'u':
+			update = 1;
+			break;
+		case 't':
+#ifndef ODROID_TRACE_USE
+			fprintf(stderr, "Traces need a build with ODROID_TRACE_USE\n");
+			return 2;
+#endif
+			trace_path = optarg;
+			break;
+		default:
+			return 2;
+		}
+	}
+
+	if (argc - optind != 2 || jobs < 1 || !interval) {
+		fprintf(stderr,
+			"usage: %s [-j jobs] [-f frames] [-n interval] [-u] [-t trace] "
+			"roms golden\n",
+			argv[0]);
+		return 2;
+	}
+
+	rom_dir = argv[optind];
+	golden_dir = argv[optind + 1];
+
+	if (regress_list_roms()) {
+		fprintf(stderr, "Can't read %s\n", rom_dir);
+		return 2;
+	}
+
+	regress_init_paths();
+	UPeriod = 0;
+
+	start = regress_time();
+	threads = calloc(jobs, sizeof(pthread_t));
+	for (index = 0; index < jobs; index++)
+		pthread_create(&threads[index], NULL, regress_thread, NULL);
+	for (index = 0; index < jobs; index++)
+		pthread_join(threads[index], NULL);
+	seconds = regress_time() - start;
+
+#ifdef ODROID_TRACE_USE
+	if (trace_path)
+		odroid_trace_dump(trace_path);
+#endif
+
+	for (index = 0; index < run_count; index++) {
+		regress_run *run = &runs[index];
+
+		total_frames += run->frame;
+		if (run->error) {
+			printf("%s: ERROR, %s\n", run->name, run->error);
+			failures++;
+		} else if (run->divergent_frame) {
+			printf("%s: DIFF, %s differs at frame %u\n", run->name,
+				run->divergent_part, run->divergent_frame);
+			failures++;
+		} else
+			printf("%s: %s, %u frames, %.0f fps\n", run->name,
+				update ? "UPDATED" : "OK", run->frame,
+				run->seconds > 0 ? run->frame / run->seconds : 0);
+	}
+
+	printf("%d roms, %d failed, %u frames in %.1fs: %.0f fps, %.1fx real time "
+		"on %d threads\n", run_count, failures, total_frames, seconds,
+		total_frames / seconds, total_frames / seconds / 60, jobs);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,215 @@
+/***************************************************************************/
+/*                                                                         */
+/*                           UDP relay Source File                         */
+/*                                                                         */
+/*     Forwards the packets of two netplay peers to each other with the    */
+/*     latency, jitter and losses of a real network, to try rollback       */
+/*     netplay on a single machine.                                        */
+/*                                                                         */
+/*     hurelay [-l latency] [-j jitter] [-x loss] port_a port_b            */
+/*                                                                         */
+/*     What comes to port_a goes to the last sender seen on port_b, and    */
+/*     the other way round. The latency and jitter are in milliseconds,    */
+/*     one way, the loss in percent. With jitter, packets get reordered.   */
+/*                                                                         */
+/***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+//! Packets on their way
+#define RELAY_QUEUE 4096
+
+#define RELAY_PACKET_SIZE 1500
+
+typedef struct {
+	double due_time;
+	//! Side the packet goes out of
+	int side;
+	int size;
+	unsigned char data[RELAY_PACKET_SIZE];
+} relay_packet;
+
+static double latency = 0.05;
+static double jitter = 0.01;
+static int loss = 0;
+
+static int sockets[2];
+static struct sockaddr_in senders[2];
+static int sender_known[2];
+
+static relay_packet *queue;
+static int queued = 0;
+
+static unsigned long relayed = 0, lost = 0, dropped = 0;
+
+
+static double
+relay_time(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+
+static int
+relay_listen(int port)
+{
+	struct sockaddr_in address = { 0 };
+	int fd;
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+	if ((fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0
+		|| bind(fd, (struct sockaddr *) &address, sizeof(address))) {
+		fprintf(stderr, "Can't listen to UDP port %d\n", port);
+		exit(2);
+	}
+	return fd;
+}
+
+
+static void
+relay_receive(int side)
+{
+	socklen_t length = sizeof(senders[side]);
+	relay_packet *packet;
+	int size;
+
+	if (queued == RELAY_QUEUE) {
+		// Full, like the buffers of a router
+		unsigned char data[RELAY_PACKET_SIZE];
+
+		recv(sockets[side], data, sizeof(data), 0);
+		dropped++;
+		return;
+	}
+
+	packet = &queue[queued];
+	size = recvfrom(sockets[side], packet->data, RELAY_PACKET_SIZE, 0,
+		(struct sockaddr *) &senders[side], &length);
+	if (size <= 0)
+		return;
+	sender_known[side] = 1;
+
+	if (rand() % 100 < loss) {
+		lost++;
+		return;
+	}
+
+	packet->side = !side;
+	packet->size = size;
+	packet->due_time = relay_time() + latency
+		+ jitter * (2.0 * rand() / RAND_MAX - 1);
+	queued++;
+}
+
+
+//! Send the packets due, return the time to wait for the next one
+static double
+relay_send(void)
+{
+	double now = relay_time(), wait = 1;
+	int index = 0;
+
+	while (index < queued) {
+		relay_packet *packet = &queue[index];
+
+		if (packet->due_time > now) {
+			if (packet->due_time - now < wait)
+				wait = packet->due_time - now;
+			index++;
+			continue;
+		}
+
+		if (sender_known[packet->side]) {
+			sendto(sockets[packet->side], packet->data, packet->size, 0,
+				(struct sockaddr *) &senders[packet->side],
+				sizeof(senders[packet->side]));
+			relayed++;
+		} else
+			dropped++;
+
+		// The order doesn't matter, the due times give it
+		*packet = queue[--queued];
+	}
+
+	return wait;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	double wait, last_report = relay_time();
+	struct timeval timeout;
+	fd_set ready;
+	int option_char, side;
+
+	while ((option_char = getopt(argc, argv, "l:j:x:")) != -1) {
+		switch (option_char) {
+		case 'l':
+			latency = atoi(optarg) / 1000.0;
+			break;
+		case 'j':
+			jitter = atoi(optarg) / 1000.0;
+			break;
+		case 'x':
+			loss = atoi(optarg);
+			break;
+		default:
+			return 2;
+		}
+	}
+
+	if (argc - optind != 2 || jitter > latency) {
+		fprintf(stderr,
+			"usage: %s [-l latency] [-j jitter] [-x loss] port_a port_b\n"
+			"the jitter can't be above the latency\n", argv[0]);
+		return 2;
+	}
+
+	sockets[0] = relay_listen(atoi(argv[optind]));
+	sockets[1] = relay_listen(atoi(argv[optind + 1]));
+	queue = calloc(RELAY_QUEUE, sizeof(relay_packet));
+	srand(time(NULL));
+
+	printf("Relaying %s <-> %s, %.0fms +-%.0fms, %d%% lost\n", argv[optind],
+		argv[optind + 1], latency * 1000, jitter * 1000, loss);
+
+	while (1) {
+		wait = relay_send();
+
+		FD_ZERO(&ready);
+		FD_SET(sockets[0], &ready);
+		FD_SET(sockets[1], &ready);
+		timeout.tv_sec = 0;
+		timeout.tv_usec = wait * 1e6;
+
+		if (select((sockets[0] > sockets[1] ? sockets[0] : sockets[1]) + 1,
+				&ready, NULL, NULL, &timeout) > 0)
+			for (side = 0; side < 2; side++)
+				if (FD_ISSET(sockets[side], &ready))
+					relay_receive(side);
+
+		if (relay_time() - last_report >= 10) {
+			printf("%lu relayed, %lu lost, %lu dropped\n", relayed, lost,
+				dropped);
+			fflush(stdout);
+			last_report = relay_time();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,266 @@
+/***************************************************************************/
+/*                                                                         */
+/*                        Rollback netplay peer Source File                */
+/*                                                                         */
+/*     Runs one rom headless at 60 fps as one player of a rollback         */
+/*     netplay session, to test it on a single machine: start a peer for   */
+/*     each player, either straight to each other or through hurelay.      */
+/*                                                                         */
+/*     hurollback [-p player] [-d delay] [-f frames] [-l port] [-i movie]  */
+/*                [-s seed] peer rom                                       */
+/*                                                                         */
+/*     peer is the host:port the inputs are sent to. The local pad plays   */
+/*     pad 1 of the movie given, else random buttons. The exit code is 1   */
+/*     if the other peer was lost or if the RAM of the peers differed at   */
+/*     one of the checks.                                                  */
+/*                                                                         */
+/***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "pce.h"
+#include "utils.h"
+
+#if !defined(MY_NETPLAY_ROLLBACK)
+#error "hurollback must be built with MY_NETPLAY_ROLLBACK"
+#endif
+
+#define HUROLLBACK_SELECT 0x04
+
+extern char *rom_file_name;
+extern char *syscard_filename;
+
+static uint32 frames = 3600;
+static uint32 seed = 1;
+//! Frames before the random pad changes
+static uint32 hold = 0;
+
+PCE_LOCAL uchar *osd_gfx_buffer = NULL;
+
+bool skipNextFrame = false;
+
+
+static void
+hurollback_frame_done(void)
+{
+}
+
+
+static int
+hurollback_gfx_init(void)
+{
+	return 0;
+}
+
+
+static int
+hurollback_gfx_mode(void)
+{
+	return 0;
+}
+
+
+static void
+hurollback_gfx_shut(void)
+{
+}
+
+
+osd_gfx_driver osd_gfx_driver_list[3] = {
+	{hurollback_gfx_init, hurollback_gfx_mode, hurollback_frame_done, hurollback_gfx_shut},
+	{hurollback_gfx_init, hurollback_gfx_mode, hurollback_frame_done, hurollback_gfx_shut},
+	{hurollback_gfx_init, hurollback_gfx_mode, hurollback_frame_done, hurollback_gfx_shut}
+};
+
+
+//! xorshift32, the same on every machine
+static uint32
+hurollback_random(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+
+int
+osd_keyboard(void)
+{
+	if (rollback.frame >= frames || !rollback_active())
+		return 1;
+
+	if (movie.mode == MOVIE_PLAY)
+		return 0;
+
+	// Random buttons held for a few frames, without the reset combination
+	if (!hold--) {
+		io.JOY[0] = hurollback_random() & ~HUROLLBACK_SELECT;
+		hold = hurollback_random() % 30;
+	}
+
+	return 0;
+}
+
+
+void
+osd_gfx_set_color(uchar index, uchar r, uchar g, uchar b)
+{
+}
+
+
+void
+osd_gfx_set_message(char *message)
+{
+}
+
+
+char
+osd_keypressed(void)
+{
+	return 0;
+}
+
+
+uint16
+osd_readkey(void)
+{
+	return 0;
+}
+
+
+void *
+my_special_alloc_try(unsigned char speed, unsigned char bytes, unsigned long size)
+{
+	return calloc(1, size);
+}
+
+
+void *
+my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long size)
+{
+	void *rc = calloc(1, size);
+
+	if (!rc)
+		abort();
+	return rc;
+}
+
+
+unsigned long
+my_special_free_largest(unsigned char speed)
+{
+	return ULONG_MAX;
+}
+
+
+bool
+my_special_release_framebuffer(void)
+{
+	return false;
+}
+
+
+void
+dump_heap_info_short(void)
+{
+}
+
+
+static void
+hurollback_init_paths(void)
+{
+	static char config_dir[] = "/tmp/hurollbackXXXXXX";
+	char **paths[] = { &cart_name, &short_cart_name, &short_iso_name,
+		&rom_file_name, &config_basepath, &sav_path, &sav_basepath,
+		&tmp_basepath, &video_path, &ISO_filename, &syscard_filename,
+		&log_filename
+	};
+	int index;
+
+	for (index = 0; index < sizeof(paths) / sizeof(paths[0]); index++)
+		*paths[index] = calloc(1, PATH_MAX);
+
+	// Both peers start with a blank backup ram
+	if (mkdtemp(config_dir))
+		strcpy(config_basepath, config_dir);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	const char *movie_path = NULL;
+	int player = 0, delay = 2, port = ROLLBACK_DEFAULT_PORT;
+	int option_char, failed;
+	uchar *xbuf;
+
+	while ((option_char = getopt(argc, argv, "p:d:f:l:i:s:")) != -1) {
+		switch (option_char) {
+		case 'p':
+			player = atoi(optarg) - 1;
+			break;
+		case 'd':
+			delay = atoi(optarg);
+			break;
+		case 'f':
+			frames = atoi(optarg);
+			break;
+		case 'l':
+			port = atoi(optarg);
+			break;
+		case 'i':
+			movie_path = optarg;
+			break;
+		case 's':
+			seed = atoi(optarg);
+			break;
+		default:
+			return 2;
+		}
+	}
+
+	if (argc - optind != 2 || !seed) {
+		fprintf(stderr,
+			"usage: %s [-p player] [-d delay] [-f frames] [-l port] "
+			"[-i movie] [-s seed] peer rom\n", argv[0]);
+		return 2;
+	}
+
+	// Each player presses its own buttons
+	seed += player;
+
+	hurollback_init_paths();
+	UPeriod = 0;
+
+	xbuf = calloc(1, XBUF_WIDTH * XBUF_HEIGHT);
+	SPM_raw = calloc(1, XBUF_WIDTH * XBUF_HEIGHT);
+	spr_init_pos = calloc(1024, sizeof(uint32));
+	osd_gfx_buffer = xbuf + 32 + 64 * XBUF_WIDTH;
+	SPM = SPM_raw + XBUF_WIDTH * 64 + 32;
+
+	if (InitPCE(argv[optind + 1]) || ResetPCE()) {
+		fprintf(stderr, "Can't run %s\n", argv[optind + 1]);
+		return 2;
+	}
+
+	if ((movie_path && movie_play(movie_path, 0))
+		|| rollback_start(player, port, argv[optind], delay)) {
+		TrashPCE();
+		return 2;
+	}
+
+	exe_go();
+
+	// Given up on the other peer, or out of sync with it
+	failed = rollback.frame < frames || rollback.desyncs;
+	rollback_stop();
+	movie_stop();
+	TrashPCE();
+
+	return failed;
+}
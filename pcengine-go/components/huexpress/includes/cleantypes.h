@@ -134,4 +134,16 @@ typedef int64 intptr;
 typedef int16_t Sint16;
 typedef signed char SBYTE;
 
+/*
+ * Storage of the engine variables making up one emulated console (see
+ * pce_instance.h). Host tools running several consoles in parallel threads
+ * define PCE_THREADED_INSTANCES so that each thread gets its own copy, other
+ * builds keep plain globals.
+ */
+#if defined(PCE_THREADED_INSTANCES)
+#define PCE_LOCAL __thread
+#else
+#define PCE_LOCAL
+#endif
+
 #endif /* __CLEANTYPES_H */
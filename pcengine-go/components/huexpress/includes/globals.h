@@ -24,8 +24,8 @@
 // Globals for PCE memory-addressing:
 //
 extern uchar * base[256];
-extern uchar * zp_base;
-extern uchar * sp_base;
+extern PCE_LOCAL uchar * zp_base;
+extern PCE_LOCAL uchar * sp_base;
 extern uchar * mmr_base[8];
 
 //
@@ -39,12 +39,12 @@ extern uchar   reg_y;
 extern uchar   reg_p;
 extern uchar   reg_s;
 */
-extern uchar * mmr;
+extern PCE_LOCAL uchar * mmr;
 
 //
 // Globals which hold emulation-realted info:
 //
-extern uint32    cycles_;
+extern PCE_LOCAL uint32    cycles_;
 extern uchar   halt_flag;
 
 //
@@ -1,15 +1,35 @@
 #pragma once
 
+#ifdef ESP_PLATFORM
 #include "esp_system.h"
+#else
+// Host tools (huregress, hurollback): no tasks, the engine runs inline
+#include <stdbool.h>
+#include <stdint.h>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#endif
 #include "../../odroid/odroid_debug.h"
+#include "../../odroid/odroid_trace.h"
 
 extern void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long size);
+extern void *my_special_alloc_try(unsigned char speed, unsigned char bytes, unsigned long size);
+extern unsigned long my_special_free_largest(unsigned char speed);
+extern bool my_special_release_framebuffer(void);
+extern void dump_heap_info_short(void);
 
 #define MY_EXCLUDE
+#ifdef ESP_PLATFORM
 #define MY_GFX_AS_TASK
 #define MY_SND_AS_TASK
+#endif
 
 //#define ODROID_DEBUG_PERF_CPU_ALL_INSTR
+//#define MY_PROFILE_PC
+//#define MY_OPCODE_STATS
+//#define MY_NETPLAY_ROLLBACK
 
 //#define MY_VIDEO_MODE_SCANLINES
 
@@ -60,7 +80,6 @@ extern void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned
 
 //#define MY_h6280_ON_CPU0  // ;-)
 
-//#define MY_REALLOC_MEMORY_SIDEARMS
 //#define MY_PCENGINE_LOGGING
 #define MY_LOG_CPU_NOT_INLINED // Slower without?!
 //#define BENCHMARK
@@ -0,0 +1,57 @@
+#ifndef _INCLUDE_TINFL_H
+#define _INCLUDE_TINFL_H
+
+/*
+ * Inflate functions of miniz. The device has them in the ESP32 ROM, host
+ * tools get the same subset from tinfl_zlib.c, on top of zlib.
+ */
+
+#ifdef ESP_PLATFORM
+#include "rom/miniz.h"
+#else
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_DECOMPRESS_MEM_TO_MEM_FAILED ((size_t) (-1))
+
+enum {
+	TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+	TINFL_FLAG_HAS_MORE_INPUT = 2,
+	TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4
+};
+
+typedef enum {
+	TINFL_STATUS_BAD_PARAM = -3,
+	TINFL_STATUS_ADLER32_MISMATCH = -2,
+	TINFL_STATUS_FAILED = -1,
+	TINFL_STATUS_DONE = 0,
+	TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+	TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+typedef struct {
+	int started;
+	z_stream stream;
+} tinfl_decompressor;
+
+#define tinfl_init(r) do { (r)->started = 0; } while (0)
+
+//! Inflate from pIn_buf_next to pOut_buf_next, the sizes are updated with
+//! the bytes used. The zlib state is released once done or failed.
+tinfl_status tinfl_decompress(tinfl_decompressor * r,
+	const uint8_t * pIn_buf_next, size_t * pIn_buf_size,
+	uint8_t * pOut_buf_start, uint8_t * pOut_buf_next,
+	size_t * pOut_buf_size, const uint32_t decomp_flags);
+
+//! Inflate a whole stream, returns its size or
+//! TINFL_DECOMPRESS_MEM_TO_MEM_FAILED
+size_t tinfl_decompress_mem_to_mem(void *pOut_buf, size_t out_buf_len,
+	const void *pSrc_buf, size_t src_buf_len, int flags);
+
+#endif /* ESP_PLATFORM */
+
+#endif /* _INCLUDE_TINFL_H */
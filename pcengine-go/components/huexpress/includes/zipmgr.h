@@ -27,4 +27,13 @@ uint32 zipmgr_extract_to_disk(char* zipFilename, char* destination);
 char* zipmgr_extract_to_memory(char* zipFilename, char* cartFilename,
 	size_t* cartSize);
 
+//! Inflate a rom straight into its final allocation, without its header
+uchar* zipmgr_extract_rom(char* zipFilename, char* cartFilename,
+	size_t* romSize);
+
+//! Find where an uncompressed entry lies in the archive, so it can be read
+//! in place. Returns 0 if it's missing or compressed
+int zipmgr_locate_stored(char* zipFilename, char* cartFilename,
+	uint32* offset, uint32* size);
+
 #endif /* ZIPMGR_H */
@@ -510,6 +510,11 @@ parse_INIfile_raw ()
 	Log ("Limiting graphics size to emulate tv output set to %d\n",
 		option.want_television_size_emulation);
 
+	option.want_cd_read_lle
+		= get_config_int("main", "cd_read_lle", 0);
+	Log ("System card code for CD_READ set to %d\n",
+		option.want_cd_read_lle);
+
 	memset(buffer, 0, BUFSIZ * sizeof(char));
 	get_config_string("main", "resource_path", "/usr/share/huexpress", buffer);
 	strcpy(option.resource_location, buffer);
@@ -664,6 +669,8 @@ save_config (void)
 				option.want_supergraphx_emulation);
 	set_config_var_int("main", "tv_size",
 				option.want_television_size_emulation);
+	set_config_var_int("main", "cd_read_lle",
+				option.want_cd_read_lle);
 	set_config_var_int("main", "hardware_format",
 				option.wanted_hardware_format);
 
@@ -632,50 +632,10 @@ osd_keyboard (void)
 
 					case SDLK_NUMLOCK:
 					{
-						if (dump_snd) {
-							uint32 dummy;
-							dummy = filesize (out_snd);
-							fseek (out_snd, 4, SEEK_SET);
-							fwrite (&dummy, 1, 4, out_snd);
-							dummy -= 0x2C;
-							fseek (out_snd, 0x28, SEEK_SET);
-							fwrite (&dummy, 1, 4, out_snd);
-							fclose (out_snd);
-							osd_gfx_set_message ("Audio dumping off");
-						} else {
-							unsigned short tmp = 0;
-							strcpy (tmp_buf, "snd0000.wav");
-							while ((tmp < 0xFFFF)
-								&& ((out_snd = fopen (tmp_buf, "rb"))
-								!= NULL)) {
-								sprintf (tmp_buf, "snd%04x.wav", ++tmp);
-								fclose(out_snd);
-							}
-							out_snd = fopen (tmp_buf, "wb");
-							fwrite ("RIFF\145\330\073\0WAVEfmt ", 16, 1, out_snd);
-							putc (0x10, out_snd);	// size
-							putc (0x00, out_snd);
-							putc (0x00, out_snd);
-							putc (0x00, out_snd);
-							putc (1, out_snd);	// PCM data
-							putc (0, out_snd);
-							putc (1, out_snd);	// mono
-							putc (0, out_snd);
-							putc (host.sound.freq, out_snd);	// frequency
-							putc (host.sound.freq >> 8, out_snd);
-							putc (host.sound.freq >> 16, out_snd);
-							putc (host.sound.freq >> 24, out_snd);
-							putc (host.sound.freq, out_snd);	// frequency
-							putc (host.sound.freq >> 8, out_snd);
-							putc (host.sound.freq >> 16, out_snd);
-							putc (host.sound.freq >> 24, out_snd);
-							putc (1, out_snd);
-							putc (0, out_snd);
-							putc (8, out_snd);	// 8 bits
-							putc (0, out_snd);
-							fwrite ("data\377\377\377\377", 1, 9, out_snd);
-							osd_gfx_set_message ("Audio dumping on");
-						}
+						if (dump_snd)
+							stop_dump_audio ();
+						else if (!start_dump_audio ())
+							break;
 						dump_snd = !dump_snd;
 						key_delay = 10;
 						message_delay = 180;
@@ -1852,9 +1812,38 @@ odroid_ui_func_toggle_rc menu_pcengine_frameskip_toggle(odroid_ui_entry *entry,
     return ODROID_UI_FUNC_TOGGLE_RC_CHANGED;
 }
 
+void menu_pcengine_audio_dump_update(odroid_ui_entry *entry) {
+    sprintf(entry->text, "%-9s: %s", "wav dump", dump_audio_running() ? "on" : "off");
+}
+
+odroid_ui_func_toggle_rc menu_pcengine_audio_dump_toggle(odroid_ui_entry *entry, odroid_gamepad_state *joystick) {
+    if (dump_audio_running())
+        stop_dump_audio();
+    else
+        start_dump_audio();
+    return ODROID_UI_FUNC_TOGGLE_RC_CHANGED;
+}
+
+#ifdef ODROID_TRACE_USE
+void menu_pcengine_trace_dump_update(odroid_ui_entry *entry) {
+    sprintf(entry->text, "%-9s: %s", "trace", "dump");
+}
+
+odroid_ui_func_toggle_rc menu_pcengine_trace_dump_toggle(odroid_ui_entry *entry, odroid_gamepad_state *joystick) {
+    char path[PATH_MAX];
+    snprintf(path, PATH_MAX, "%s/trace.json", config_basepath);
+    odroid_trace_dump(path);
+    return ODROID_UI_FUNC_TOGGLE_RC_NOTHING;
+}
+#endif
+
 void menu_pceninge_init(odroid_ui_window *window) {
     odroid_ui_create_entry(window, &menu_pcengine_audio_update, &menu_pcengine_audio_toggle);
     odroid_ui_create_entry(window, &menu_pcengine_frameskip_update, &menu_pcengine_frameskip_toggle);
+    odroid_ui_create_entry(window, &menu_pcengine_audio_dump_update, &menu_pcengine_audio_dump_toggle);
+#ifdef ODROID_TRACE_USE
+    odroid_ui_create_entry(window, &menu_pcengine_trace_dump_update, &menu_pcengine_trace_dump_toggle);
+#endif
 }
 
 int
@@ -523,6 +523,7 @@ inline void update_ui_fps() {
     odroid_debug_perf_log_one("Mem Op Acc" , ODROID_DEBUG_PERF_MEM_ACCESS1);
 #endif
 ODROID_DEBUG_PERF_LOG()
+    opcode_stats_tick();
     }
     startTime = stopTime;
 }
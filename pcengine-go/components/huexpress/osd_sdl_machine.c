@@ -8,7 +8,7 @@ int netplay_mode;
 char initial_path[PATH_MAX] = "";
 // prefered path for for searching
 
-uchar* osd_gfx_buffer = NULL;
+PCE_LOCAL uchar* osd_gfx_buffer = NULL;
 
 uchar gamepad = 0;
 // gamepad detected ?
@@ -92,7 +92,7 @@ osd_shut_machine (void)
 		SDL_RemoveTimer(timerId);
 
 	if (dump_snd)
-		fclose(out_snd);
+		stop_dump_audio();
 
 	TrashSound();
 
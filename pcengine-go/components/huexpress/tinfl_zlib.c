@@ -0,0 +1,92 @@
+#include "tinfl.h"
+
+#ifndef ESP_PLATFORM
+
+#include <string.h>
+
+/*
+ * The miniz inflate subset used by zipmgr.c and isq.c, for the host tools.
+ * zlib keeps its own window, the output buffer doesn't need to hold the
+ * previous bytes as the miniz dictionary does.
+ */
+
+
+static int
+tinfl_window_bits(uint32_t flags)
+{
+	// Raw deflate streams unless a zlib header is expected
+	return flags & TINFL_FLAG_PARSE_ZLIB_HEADER ? 15 : -15;
+}
+
+
+tinfl_status
+tinfl_decompress(tinfl_decompressor * r, const uint8_t * pIn_buf_next,
+	size_t * pIn_buf_size, uint8_t * pOut_buf_start,
+	uint8_t * pOut_buf_next, size_t * pOut_buf_size,
+	const uint32_t decomp_flags)
+{
+	z_stream *stream = &r->stream;
+	int result;
+
+	if (!r->started) {
+		memset(stream, 0, sizeof(z_stream));
+		if (inflateInit2(stream, tinfl_window_bits(decomp_flags)) != Z_OK)
+			return TINFL_STATUS_FAILED;
+		r->started = 1;
+	}
+
+	stream->next_in = (Bytef *) pIn_buf_next;
+	stream->avail_in = *pIn_buf_size;
+	stream->next_out = pOut_buf_next;
+	stream->avail_out = *pOut_buf_size;
+
+	result = inflate(stream, Z_NO_FLUSH);
+
+	*pIn_buf_size -= stream->avail_in;
+	*pOut_buf_size -= stream->avail_out;
+
+	if (result == Z_STREAM_END) {
+		inflateEnd(stream);
+		r->started = 0;
+		return TINFL_STATUS_DONE;
+	}
+
+	if ((result != Z_OK && result != Z_BUF_ERROR)
+		|| (!stream->avail_in && stream->avail_out
+			&& !(decomp_flags & TINFL_FLAG_HAS_MORE_INPUT))) {
+		// Broken stream, or it ends before its last block
+		inflateEnd(stream);
+		r->started = 0;
+		return TINFL_STATUS_FAILED;
+	}
+
+	return stream->avail_out ? TINFL_STATUS_NEEDS_MORE_INPUT
+		: TINFL_STATUS_HAS_MORE_OUTPUT;
+}
+
+
+size_t
+tinfl_decompress_mem_to_mem(void *pOut_buf, size_t out_buf_len,
+	const void *pSrc_buf, size_t src_buf_len, int flags)
+{
+	z_stream stream;
+	int result;
+
+	memset(&stream, 0, sizeof(z_stream));
+	if (inflateInit2(&stream, tinfl_window_bits(flags)) != Z_OK)
+		return TINFL_DECOMPRESS_MEM_TO_MEM_FAILED;
+
+	stream.next_in = (Bytef *) pSrc_buf;
+	stream.avail_in = src_buf_len;
+	stream.next_out = pOut_buf;
+	stream.avail_out = out_buf_len;
+
+	result = inflate(&stream, Z_FINISH);
+	inflateEnd(&stream);
+
+	if (result != Z_STREAM_END)
+		return TINFL_DECOMPRESS_MEM_TO_MEM_FAILED;
+	return out_buf_len - stream.avail_out;
+}
+
+#endif /* !ESP_PLATFORM */
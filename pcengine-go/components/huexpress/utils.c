@@ -31,6 +31,9 @@
 #include <stdlib.h>
 
 #include "utils.h"
+#ifdef MY_SND_AS_TASK
+#include "../odroid/odroid_audio.h"
+#endif
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -107,6 +110,14 @@ wait_next_vsync()
 	double curtime;
 	const double deltatime = (1.0 / 60.0);
 
+#ifdef MY_SND_AS_TASK
+	// With audio sync on, the I2S clock paces the frames
+	if (odroid_audio_sync_wait(60)) {
+		lasttime = osd_getTime();
+		return;
+	}
+#endif
+
 	curtime = osd_getTime();
 
 	osd_sleep(lasttime + deltatime - curtime);
@@ -191,10 +191,325 @@ zipmgr_extract_to_memory(char* zipFilename, char* cartFilename,
 	return extractedCart;
 }
 #else
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include "tinfl.h"
+
+#include "debug.h"
+#include "myadd.h"
+
+/*
+ * Minimal reader of the zip format, enough to find an entry from the
+ * central directory and to stream it out. Deflated entries are inflated
+ * with the miniz decoder from the ESP32 ROM (zlib on the host).
+ */
+
+#define ZIP_LOCAL_SIGNATURE 0x04034b50
+#define ZIP_CENTRAL_SIGNATURE 0x02014b50
+#define ZIP_END_SIGNATURE 0x06054b50
+
+#define ZIP_LOCAL_SIZE 30
+#define ZIP_CENTRAL_SIZE 46
+#define ZIP_END_SIZE 22
+
+//! Tail of the archive searched for the end of central directory record,
+//! archives with a longer comment aren't recognized
+#define ZIP_END_SEARCH 1024
+
+//! Compressed bytes read at once while inflating
+#define ZIP_READ_CHUNK 4096
+
+#define ZIP_METHOD_STORED 0
+#define ZIP_METHOD_DEFLATED 8
+
+typedef struct {
+	char name[256];
+	uint16 method;
+	uint32 packed_size;
+	uint32 size;
+	uint32 header_offset;
+} zip_entry;
+
+typedef struct {
+	FILE *file;
+	uint32 position;
+	uint16 entries_left;
+} zip_directory;
+
+
+static uint16
+get_le16(uchar * p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+
+static uint32
+get_le32(uchar * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+
+//! Find the central directory, returns 0 if the file isn't a zip archive
+static int
+zip_open_directory(char *zipFilename, zip_directory * directory)
+{
+	uchar tail[ZIP_END_SEARCH];
+	long size, length;
+	int i;
+
+	if (!(directory->file = fopen(zipFilename, "rb")))
+		return 0;
+
+	fseek(directory->file, 0, SEEK_END);
+	size = ftell(directory->file);
+	length = size < ZIP_END_SEARCH ? size : ZIP_END_SEARCH;
+
+	if (length >= ZIP_END_SIZE
+		&& fseek(directory->file, size - length, SEEK_SET) == 0
+		&& fread(tail, 1, length, directory->file) == length) {
+		for (i = length - ZIP_END_SIZE; i >= 0; i--)
+			if (get_le32(tail + i) == ZIP_END_SIGNATURE) {
+				directory->entries_left = get_le16(tail + i + 10);
+				directory->position = get_le32(tail + i + 16);
+				return 1;
+			}
+	}
+
+	MESSAGE_ERROR("Zip %s error: no central directory\n", zipFilename);
+	fclose(directory->file);
+	return 0;
+}
+
+
+static int
+zip_next_entry(zip_directory * directory, zip_entry * entry)
+{
+	uchar header[ZIP_CENTRAL_SIZE];
+	uint16 name_length;
+
+	if (!directory->entries_left
+		|| fseek(directory->file, directory->position, SEEK_SET)
+		|| fread(header, ZIP_CENTRAL_SIZE, 1, directory->file) != 1
+		|| get_le32(header) != ZIP_CENTRAL_SIGNATURE)
+		return 0;
+
+	name_length = get_le16(header + 28);
+
+	entry->method = get_le16(header + 10);
+	entry->packed_size = get_le32(header + 20);
+	entry->size = get_le32(header + 24);
+	entry->header_offset = get_le32(header + 42);
+
+	memset(entry->name, 0, sizeof(entry->name));
+	if (name_length >= sizeof(entry->name))
+		name_length = sizeof(entry->name) - 1;
+	if (fread(entry->name, 1, name_length, directory->file) != name_length)
+		return 0;
+
+	directory->position += ZIP_CENTRAL_SIZE + get_le16(header + 28)
+		+ get_le16(header + 30) + get_le16(header + 32);
+	directory->entries_left--;
+	return 1;
+}
+
+
+//! Look for cartFilename, returns the offset of its data or 0
+static uint32
+zip_find_entry(zip_directory * directory, char *cartFilename,
+	zip_entry * entry)
+{
+	uchar header[ZIP_LOCAL_SIZE];
+
+	while (zip_next_entry(directory, entry)) {
+		if (strcmp(entry->name, cartFilename))
+			continue;
+
+		if (fseek(directory->file, entry->header_offset, SEEK_SET)
+			|| fread(header, ZIP_LOCAL_SIZE, 1, directory->file) != 1
+			|| get_le32(header) != ZIP_LOCAL_SIGNATURE)
+			return 0;
+
+		return entry->header_offset + ZIP_LOCAL_SIZE
+			+ get_le16(header + 26) + get_le16(header + 28);
+	}
+
+	return 0;
+}
+
+
 uint32
 zipmgr_probe_file(char* zipFilename, char* foundGameFile)
 {
-    return 0;
+	zip_directory directory;
+	zip_entry entry;
+	uint32 result = ZIP_HAS_NONE;
+
+	if (!zip_open_directory(zipFilename, &directory))
+		return ZIP_ERROR;
+
+	while (zip_next_entry(&directory, &entry)) {
+		if (strcasestr(entry.name, ".PCE"))
+			result = ZIP_HAS_PCE;
+		else if (strcasestr(entry.name, ".ISO"))
+			result = ZIP_HAS_ISO;
+		else
+			continue;
+
+		MESSAGE_INFO("Found %s within zip file\n", entry.name);
+		strcpy(foundGameFile, entry.name);
+		break;
+	}
+
+	fclose(directory.file);
+	return result;
+}
+
+
+//! Inflate an entry, handing out the bytes between skip and size
+static int
+zip_inflate(FILE * file, zip_entry * entry, uint32 skip, uchar * output)
+{
+	tinfl_decompressor *inflator;
+	uchar *dictionary, *input;
+	uint32 packed_left = entry->packed_size, position = 0;
+	size_t input_offset = 0, input_length = 0, dictionary_offset = 0;
+	tinfl_status status;
+
+	inflator = (tinfl_decompressor *) my_special_alloc(false, 4,
+		sizeof(tinfl_decompressor));
+	dictionary = (uchar *) my_special_alloc(false, 1, TINFL_LZ_DICT_SIZE);
+	input = (uchar *) my_special_alloc(false, 1, ZIP_READ_CHUNK);
+
+	tinfl_init(inflator);
+
+	do {
+		size_t in_bytes, out_bytes;
+
+		if (!input_length && packed_left) {
+			input_length = fread(input, 1, packed_left < ZIP_READ_CHUNK
+				? packed_left : ZIP_READ_CHUNK, file);
+			if (!input_length) {
+				status = TINFL_STATUS_FAILED;
+				break;
+			}
+			packed_left -= input_length;
+			input_offset = 0;
+		}
+
+		in_bytes = input_length;
+		out_bytes = TINFL_LZ_DICT_SIZE - dictionary_offset;
+		status = tinfl_decompress(inflator, input + input_offset, &in_bytes,
+			dictionary, dictionary + dictionary_offset, &out_bytes,
+			packed_left ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+
+		input_offset += in_bytes;
+		input_length -= in_bytes;
+
+		// Drop the header on the fly, keep the rest in place
+		if (position + out_bytes > skip && position < entry->size) {
+			uint32 begin = position < skip ? skip - position : 0;
+			uint32 end = entry->size - position < out_bytes
+				? entry->size - position : out_bytes;
+
+			memcpy(output + position + begin - skip,
+				dictionary + dictionary_offset + begin, end - begin);
+		}
+
+		position += out_bytes;
+		dictionary_offset = (dictionary_offset + out_bytes)
+			& (TINFL_LZ_DICT_SIZE - 1);
+	} while (status > TINFL_STATUS_DONE);
+
+	free(input);
+	free(dictionary);
+	free(inflator);
+
+	return status == TINFL_STATUS_DONE && position == entry->size;
+}
+
+
+uchar*
+zipmgr_extract_rom(char* zipFilename, char* cartFilename, size_t* romSize)
+{
+	zip_directory directory;
+	zip_entry entry;
+	uint32 offset, header;
+	uchar *rom;
+	int result = 0;
+
+	if (!zip_open_directory(zipFilename, &directory))
+		return NULL;
+
+	if (!(offset = zip_find_entry(&directory, cartFilename, &entry))
+		|| fseek(directory.file, offset, SEEK_SET)) {
+		MESSAGE_ERROR("Zip %s error: %s not found\n", zipFilename,
+			cartFilename);
+		fclose(directory.file);
+		return NULL;
+	}
+
+	header = entry.size & 0x1FFF;
+	*romSize = entry.size & ~0x1FFF;
+	if (!*romSize) {
+		fclose(directory.file);
+		return NULL;
+	}
+	rom = (uchar *) my_special_alloc(false, 1, *romSize);
+
+	switch (entry.method) {
+	case ZIP_METHOD_STORED:
+		result = fseek(directory.file, offset + header, SEEK_SET) == 0
+			&& fread(rom, 1, *romSize, directory.file) == *romSize;
+		break;
+	case ZIP_METHOD_DEFLATED:
+		result = zip_inflate(directory.file, &entry, header, rom);
+		break;
+	default:
+		MESSAGE_ERROR("Zip %s error: method %d not supported\n",
+			zipFilename, entry.method);
+	}
+
+	fclose(directory.file);
+
+	if (!result) {
+		MESSAGE_ERROR("Error reading file from zip archive!\n");
+		free(rom);
+		return NULL;
+	}
+
+	return rom;
+}
+
+
+int
+zipmgr_locate_stored(char* zipFilename, char* cartFilename,
+	uint32* offset, uint32* size)
+{
+	zip_directory directory;
+	zip_entry entry;
+
+	if (!zip_open_directory(zipFilename, &directory))
+		return 0;
+
+	*offset = zip_find_entry(&directory, cartFilename, &entry);
+	fclose(directory.file);
+
+	if (!*offset)
+		return 0;
+	*size = entry.size;
+
+	if (entry.method != ZIP_METHOD_STORED) {
+		MESSAGE_ERROR("Zip %s error: %s is compressed, only stored images "
+			"can be read in place\n", zipFilename, cartFilename);
+		return 0;
+	}
+
+	return 1;
 }
 
 char*
@@ -204,9 +519,13 @@ zipmgr_extract_to_memory(char* zipFilename, char* cartFilename,
     return NULL;
 }
 
+//! There is no room to extract images on the card, compressed CD images
+//! can't be used
 uint32
 zipmgr_extract_to_disk(char* zipFilename, char* destination)
 {
-    return 0;
+    MESSAGE_ERROR("Zip %s error: compressed CD images aren't supported, "
+        "store them uncompressed\n", zipFilename);
+    return 1;
 }
 #endif
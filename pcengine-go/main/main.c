@@ -13,8 +13,6 @@
 #include "pce.h"
 
 extern char *rom_file_name;
-extern uchar *SPM_raw;
-extern uchar *SPM;
 extern char *syscard_filename;
 
 /////////
@@ -40,7 +38,7 @@ const char* SD_BASE_PATH = "/sd";
 #define PATH_MAX_MY 128
 
 #define TASK_BREAK (void*)1
-uchar* osd_gfx_buffer = NULL;
+PCE_LOCAL uchar* osd_gfx_buffer = NULL;
 uchar* XBuf;
 #ifdef MY_GFX_AS_TASK
 QueueHandle_t vidQueue;
@@ -61,9 +59,10 @@ void dump_heap_info_short() {
     printf("LARGEST: 32BIT: %u\n", heap_caps_get_largest_free_block( MALLOC_CAP_INTERNAL | MALLOC_CAP_32BIT ));
     printf("LARGEST: MALLOC_CAP_INTERNAL: %u\n", heap_caps_get_largest_free_block( MALLOC_CAP_INTERNAL ));
     printf("LARGEST: MALLOC_CAP_DEFAULT: %u\n", heap_caps_get_largest_free_block( MALLOC_CAP_DEFAULT ));
+    printf("FREE: SPIRAM: %u; LARGEST: %u\n", heap_caps_get_free_size( MALLOC_CAP_SPIRAM ), heap_caps_get_largest_free_block( MALLOC_CAP_SPIRAM ));
 }
 
-void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long size) {
+void *my_special_alloc_try(unsigned char speed, unsigned char bytes, unsigned long size) {
     uint32_t caps = (speed?MALLOC_CAP_INTERNAL:MALLOC_CAP_SPIRAM) | 
       ( bytes==1?MALLOC_CAP_8BIT:MALLOC_CAP_32BIT);
       /*
@@ -81,10 +80,28 @@ void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long s
     //if (!speed || size!=65536) caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_32BIT; // only RAM
     void *rc = heap_caps_malloc(size, caps);
     printf("ALLOC: Size: %-10u; SPI: %u; 32BIT: %u; RC: %p\n", (unsigned int)size, (caps&MALLOC_CAP_SPIRAM)!=0, (caps&MALLOC_CAP_32BIT)!=0, rc);
+    return rc;
+}
+
+void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long size) {
+    void *rc = my_special_alloc_try(speed, bytes, size);
     if (!rc) { dump_heap_info_short(); abort(); }
     return rc;
 }
 
+unsigned long my_special_free_largest(unsigned char speed) {
+    return heap_caps_get_largest_free_block(speed?MALLOC_CAP_INTERNAL:MALLOC_CAP_SPIRAM);
+}
+
+// Give back the second frame buffer, the display is single buffered afterwards
+bool my_special_release_framebuffer() {
+    if (framebuffer[1] == framebuffer[0]) return false;
+    printf("app_main: releasing framebuffer[1]=%p\n", framebuffer[1]);
+    heap_caps_free(framebuffer[1]);
+    framebuffer[1] = framebuffer[0];
+    return true;
+}
+
 #ifdef MY_GFX_AS_TASK
 
 #ifdef MY_VIDEO_MODE_SCANLINES
@@ -102,7 +119,9 @@ void *my_special_alloc(unsigned char speed, unsigned char bytes, unsigned long s
             break; \
  \
         odroid_display_lock(); \
+        ODROID_TRACE_BEGIN(ODROID_TRACE_VIDEO) \
         func(&param, my_palette); \
+        ODROID_TRACE_END(ODROID_TRACE_VIDEO) \
         odroid_display_unlock(); \
         /* odroid_input_battery_level_read(&battery);*/ \
         xQueueReceive(vidQueue, &param, portMAX_DELAY); \
@@ -139,7 +158,9 @@ void videoTask_mode0_w336(void *arg) { VID_TASK(ili9341_write_frame_pcengine_mod
             break; \
  \
         odroid_display_lock(); \
+        ODROID_TRACE_BEGIN(ODROID_TRACE_VIDEO) \
         func(param, my_palette); \
+        ODROID_TRACE_END(ODROID_TRACE_VIDEO) \
         odroid_display_unlock(); \
         /* odroid_input_battery_level_read(&battery);*/ \
         xQueueReceive(vidQueue, &param, portMAX_DELAY); \
@@ -163,16 +184,19 @@ void videoTask_mode0_w336(void *arg) { VID_TASK(ili9341_write_frame_pcengine_mod
 
 #ifdef MY_SND_AS_TASK
 #define AUDIO_SAMPLE_RATE (22050)
-#define AUDIO_BUFFER_SIZE (4096) 
-//(1920*4)
 #define AUDIO_CHANNELS 6
 short *sbuf_mix[2];
 char *sbuf[AUDIO_CHANNELS];
+int audio_sync_target = 0;
+int audio_block_frames = ODROID_AUDIO_BLOCK_DEFAULT;
 void audioTask_mode0(void *arg) {
     uint8_t* param;
     audioTaskIsRunning = true;
     printf("%s: STARTED\n", __func__);
     uint8_t buf = 0;
+    int sync_frame = frame;
+    int sync_due = 0;
+    int stat_blocks = 0;
     
     while(1)
     {
@@ -182,26 +206,55 @@ void audioTask_mode0(void *arg) {
                 break;
             xQueueReceive(audioQueue, &param, portMAX_DELAY);
         }
-        //memset(sbuf[buf], 0, AUDIO_BUFFER_SIZE);
+        //memset(sbuf[buf], 0, audio_block_frames * 4);
         if (odroid_ui_menu_opened)
         {
             usleep(100*1000);
             continue;
         }
-        usleep(10*1000);
+        if (audio_sync_target)
+        {
+            // Produce audio as the emulation runs, the emulation itself is
+            // paced by the I2S output in odroid_audio_sync_wait. What is left
+            // of the drift is absorbed by the rate controller in odroid_audio
+            if (frame < sync_frame) sync_frame = frame;
+            sync_due += (frame - sync_frame) * AUDIO_SAMPLE_RATE;
+            sync_frame = frame;
+            if (sync_due > audio_block_frames * 60 * 4) sync_due = audio_block_frames * 60 * 4;
+            if (sync_due < audio_block_frames * 60)
+            {
+                // A block lasts several ticks, wait for one. usleep below a tick
+                // busy-waits and would starve the emulation on this core
+                vTaskDelay(1);
+                continue;
+            }
+            sync_due -= audio_block_frames * 60;
+        }
+        else
+        {
+            usleep(10*1000);
+        }
+        if (++stat_blocks >= AUDIO_SAMPLE_RATE * 5 / audio_block_frames)
+        {
+            printf("AUDIO: latency=%dms drift=%dppm underruns=%d blocked=%dms\n",
+                odroid_audio_latency_get(), odroid_audio_drift_get(),
+                odroid_audio_underruns_get(), odroid_audio_blocked_ms_get());
+            stat_blocks = 0;
+        }
         char *sbufp[AUDIO_CHANNELS];
         for (int i = 0;i < AUDIO_CHANNELS;i++)
         {
           sbufp[i] = sbuf[i];
-          WriteBuffer((char*)sbuf[i], i, AUDIO_BUFFER_SIZE/2);
+          WriteBuffer((char*)sbuf[i], i, audio_block_frames * 2);
         }
+        write_adpcm_block(audio_block_frames * 2);
         /*
         uchar lvol, rvol;
         lvol = (io.psg_volume >> 4) * 1.22;
         rvol = (io.psg_volume & 0x0F) * 1.22;
         
         short *p = sbuf_mix[buf];
-        for (int i = 0;i < AUDIO_BUFFER_SIZE/2;i++)
+        for (int i = 0;i < audio_block_frames;i++)
         {
              short lval = 0;
              short rval = 0;
@@ -223,7 +276,8 @@ void audioTask_mode0(void *arg) {
         rvol = (io.psg_volume & 0x0F) * 1.22;
         
         short *p = sbuf_mix[buf];
-        for (int i = 0;i < AUDIO_BUFFER_SIZE/2;i++)
+        // The channel buffers hold interleaved stereo, one frame is two bytes
+        for (int i = 0;i < audio_block_frames*2;i+=2)
         {
              short lval = 0;
              short rval = 0;
@@ -232,6 +286,9 @@ void audioTask_mode0(void *arg) {
                 lval+=( short)sbufp[j][i];
                 rval+=( short)sbufp[j][i+1];
             }
+            // ADPCM is mixed as a seventh channel
+            lval+=( short)adpcmbuf[i];
+            rval+=( short)adpcmbuf[i+1];
             //lval = lval/AUDIO_CHANNELS;
             //rval = rval/AUDIO_CHANNELS;
             lval = lval * lvol;
@@ -241,7 +298,15 @@ void audioTask_mode0(void *arg) {
             p+=2;
         }
         
-        odroid_audio_submit((short*)sbuf_mix[buf], AUDIO_BUFFER_SIZE/4);
+        // CD audio tracks come in at their own rate and volume
+        cdda_mix((short*)sbuf_mix[buf], audio_block_frames, AUDIO_SAMPLE_RATE);
+        
+        // Only copied here, the SD card is written by the dump task
+        dump_audio_chunck((uchar*)sbuf_mix[buf], audio_block_frames * 4);
+        
+        ODROID_TRACE_BEGIN(ODROID_TRACE_AUDIO)
+        odroid_audio_submit((short*)sbuf_mix[buf], audio_block_frames);
+        ODROID_TRACE_END(ODROID_TRACE_AUDIO)
         buf = buf?0:1;
     }
     xQueueReceive(audioQueue, &param, portMAX_DELAY);
@@ -322,6 +387,10 @@ void EmuAudio(bool enable)
 
 void DoMenuHome(bool save)
 {
+    // Fills the length of a recording
+    movie_stop();
+    profile_dump();
+
     // Clear audio to prevent studdering
     printf("PowerDown: stopping audio.\n");
 #ifdef MY_SND_AS_TASK
@@ -430,7 +499,11 @@ NOINLINE void app_init(void)
     
     odroid_audio_init(odroid_settings_AudioSink_get(), AUDIO_SAMPLE_RATE);
     
-    InitPCE(rom_file);
+    if (InitPCE(rom_file))
+    {
+        odroid_ui_error("Couldn't load the game");
+        abort();
+    }
     osd_init_machine();
 #ifdef MY_GFX_AS_TASK
     update_display_task(77);
@@ -440,12 +513,17 @@ NOINLINE void app_init(void)
     host.sound.signed_sound = false;
     host.sound.freq = AUDIO_SAMPLE_RATE;
     host.sound.sample_size = 1;
+    audio_block_frames = odroid_audio_block_frames_get();
     for (int i = 0;i < AUDIO_CHANNELS; i++)
     {
-        sbuf[i] = my_special_alloc(false, 1, AUDIO_BUFFER_SIZE/2);
+        sbuf[i] = my_special_alloc(false, 1, audio_block_frames * 2);
     } 
-    sbuf_mix[0] = my_special_alloc(false, 1, AUDIO_BUFFER_SIZE);
-    sbuf_mix[1] = my_special_alloc(false, 1, AUDIO_BUFFER_SIZE);
+    adpcmbuf = my_special_alloc(false, 1, audio_block_frames * 2);
+    sbuf_mix[0] = my_special_alloc(false, 1, audio_block_frames * 4);
+    sbuf_mix[1] = my_special_alloc(false, 1, audio_block_frames * 4);
+    
+    audio_sync_target = odroid_settings_AudioLatency_get();
+    odroid_audio_sync_set(audio_sync_target);
     
     audioQueue = xQueueCreate(1, sizeof(uint16_t*));
     EmuAudio(true);
@@ -453,9 +531,25 @@ NOINLINE void app_init(void)
 #endif
 }
 
+// Hold SELECT while the game starts to record its input, START to replay the
+// recording as fast as possible (benchmark)
+NOINLINE void app_movie(void)
+{
+    char path[PATH_MAX_MY];
+    odroid_gamepad_state joystick;
+
+    odroid_input_gamepad_read(&joystick);
+    snprintf(path, sizeof(path), "%s/%shmv", config_basepath, short_cart_name);
+    if (joystick.values[ODROID_INPUT_SELECT])
+        movie_record(path);
+    else if (joystick.values[ODROID_INPUT_START])
+        movie_play(path, true);
+}
+
 NOINLINE void app_loop(void)
 {
    printf("up and running\n");
+   app_movie();
    //if (!(*osd_gfx_driver_list[video_driver].init) ())
    odroid_ui_enter_loop();
    RunPCE();